@@ -474,9 +474,11 @@ namespace Types::Blockchain
          * Quick and dirty checks to validate that the construction of the block is correct.
          * It does not; however, verify that the proper parties have signed the block or
          * that the resulting coinbase transaction was constructed correctly (correct recipients, etc).
+         * The verification of the signatures may be skipped for blocks that are assumed valid.
+         * @param check_signatures
          * @return
          */
-        [[nodiscard]] bool validate_construction() const
+        [[nodiscard]] bool validate_construction(bool check_signatures = true) const
         {
             if (!std::visit(
                     [](auto &&arg)
@@ -507,6 +509,11 @@ namespace Types::Blockchain
                 return false;
             }
 
+            if (!check_signatures)
+            {
+                return producer_public_key != Crypto::Z && !producer_signature.empty() && !validator_signatures.empty();
+            }
+
             // check the producer signature
             if (!validate_producer_signature())
             {
@@ -0,0 +1,293 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_BLOCK_SYNC_DATA_H
+#define TURTLECOIN_BLOCK_SYNC_DATA_H
+
+#include "base_types.h"
+
+namespace Types::Blockchain
+{
+    /**
+     * The portion of a transaction that a wallet requires to scan it for outputs
+     * that belong to the wallet and for key images that the wallet has spent
+     *
+     * Outputs are identified globally by their hash which the wallet recomputes
+     * from the output itself; as such, it is not repeated here
+     */
+    struct transaction_sync_data_t : virtual ISerializable
+    {
+        transaction_sync_data_t() {}
+
+        transaction_sync_data_t(deserializer_t &reader)
+        {
+            deserialize(reader);
+        }
+
+        transaction_sync_data_t(const std::vector<uint8_t> &data)
+        {
+            deserializer_t reader(data);
+
+            deserialize(reader);
+        }
+
+        JSON_OBJECT_CONSTRUCTORS(transaction_sync_data_t, fromJSON)
+
+        void deserialize(deserializer_t &reader) override
+        {
+            txn_hash = reader.key<crypto_hash_t>();
+
+            unlock_block = reader.varint<uint64_t>();
+
+            public_key = reader.key<crypto_public_key_t>();
+
+            key_images = reader.keyV<crypto_key_image_t>();
+
+            // outputs
+            {
+                const auto count = reader.varint<uint64_t>();
+
+                outputs.clear();
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    outputs.emplace_back(reader);
+                }
+            }
+        }
+
+        JSON_FROM_FUNC(fromJSON) override
+        {
+            JSON_OBJECT_OR_THROW();
+
+            LOAD_KEY_FROM_JSON(txn_hash);
+
+            LOAD_U64_FROM_JSON(unlock_block);
+
+            LOAD_KEY_FROM_JSON(public_key);
+
+            LOAD_KEYV_FROM_JSON(key_images);
+
+            JSON_MEMBER_OR_THROW("outputs");
+
+            outputs.clear();
+
+            for (const auto &elem : get_json_array(j, "outputs"))
+            {
+                outputs.emplace_back(elem);
+            }
+        }
+
+        void serialize(serializer_t &writer) const override
+        {
+            txn_hash.serialize(writer);
+
+            writer.varint(unlock_block);
+
+            public_key.serialize(writer);
+
+            writer.key(key_images);
+
+            writer.varint(outputs.size());
+
+            for (const auto &output : outputs)
+            {
+                output.serialize(writer);
+            }
+        }
+
+        [[nodiscard]] std::vector<uint8_t> serialize() const override
+        {
+            serializer_t writer;
+
+            serialize(writer);
+
+            return writer.vector();
+        }
+
+        [[nodiscard]] size_t size() const override
+        {
+            return serialize().size();
+        }
+
+        JSON_TO_FUNC(toJSON) override
+        {
+            writer.StartObject();
+            {
+                KEY_TO_JSON(txn_hash);
+
+                U64_TO_JSON(unlock_block);
+
+                KEY_TO_JSON(public_key);
+
+                KEYV_TO_JSON(key_images);
+
+                writer.Key("outputs");
+                writer.StartArray();
+                {
+                    for (const auto &output : outputs)
+                    {
+                        output.toJSON(writer);
+                    }
+                }
+                writer.EndArray();
+            }
+            writer.EndObject();
+        }
+
+        [[nodiscard]] std::string to_string() const override
+        {
+            const auto bytes = serialize();
+
+            return Crypto::StringTools::to_hex(bytes.data(), bytes.size());
+        }
+
+        crypto_hash_t txn_hash;
+
+        uint64_t unlock_block = 0;
+
+        crypto_public_key_t public_key;
+
+        std::vector<crypto_key_image_t> key_images;
+
+        std::vector<transaction_output_t> outputs;
+    };
+
+    /**
+     * The compact projection of a block that is served to wallets during sync in place
+     * of the full block and its transactions
+     *
+     * Transactions that contain neither outputs nor key images (ie. the staker reward
+     * transaction) are omitted entirely
+     */
+    struct block_sync_data_t : virtual ISerializable
+    {
+        block_sync_data_t() {}
+
+        block_sync_data_t(deserializer_t &reader)
+        {
+            deserialize(reader);
+        }
+
+        block_sync_data_t(const std::vector<uint8_t> &data)
+        {
+            deserializer_t reader(data);
+
+            deserialize(reader);
+        }
+
+        JSON_OBJECT_CONSTRUCTORS(block_sync_data_t, fromJSON)
+
+        void deserialize(deserializer_t &reader) override
+        {
+            block_index = reader.varint<uint64_t>();
+
+            block_hash = reader.key<crypto_hash_t>();
+
+            timestamp = reader.varint<uint64_t>();
+
+            // transactions
+            {
+                const auto count = reader.varint<uint64_t>();
+
+                transactions.clear();
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    transactions.emplace_back(reader);
+                }
+            }
+        }
+
+        JSON_FROM_FUNC(fromJSON) override
+        {
+            JSON_OBJECT_OR_THROW();
+
+            LOAD_U64_FROM_JSON(block_index);
+
+            LOAD_KEY_FROM_JSON(block_hash);
+
+            LOAD_U64_FROM_JSON(timestamp);
+
+            JSON_MEMBER_OR_THROW("transactions");
+
+            transactions.clear();
+
+            for (const auto &elem : get_json_array(j, "transactions"))
+            {
+                transactions.emplace_back(elem);
+            }
+        }
+
+        void serialize(serializer_t &writer) const override
+        {
+            writer.varint(block_index);
+
+            block_hash.serialize(writer);
+
+            writer.varint(timestamp);
+
+            writer.varint(transactions.size());
+
+            for (const auto &transaction : transactions)
+            {
+                transaction.serialize(writer);
+            }
+        }
+
+        [[nodiscard]] std::vector<uint8_t> serialize() const override
+        {
+            serializer_t writer;
+
+            serialize(writer);
+
+            return writer.vector();
+        }
+
+        [[nodiscard]] size_t size() const override
+        {
+            return serialize().size();
+        }
+
+        JSON_TO_FUNC(toJSON) override
+        {
+            writer.StartObject();
+            {
+                U64_TO_JSON(block_index);
+
+                KEY_TO_JSON(block_hash);
+
+                U64_TO_JSON(timestamp);
+
+                writer.Key("transactions");
+                writer.StartArray();
+                {
+                    for (const auto &transaction : transactions)
+                    {
+                        transaction.toJSON(writer);
+                    }
+                }
+                writer.EndArray();
+            }
+            writer.EndObject();
+        }
+
+        [[nodiscard]] std::string to_string() const override
+        {
+            const auto bytes = serialize();
+
+            return Crypto::StringTools::to_hex(bytes.data(), bytes.size());
+        }
+
+        uint64_t block_index = 0;
+
+        crypto_hash_t block_hash;
+
+        uint64_t timestamp = 0;
+
+        std::vector<transaction_sync_data_t> transactions;
+    };
+} // namespace Types::Blockchain
+
+#endif // TURTLECOIN_BLOCK_SYNC_DATA_H
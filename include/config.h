@@ -169,6 +169,92 @@ namespace Configuration
          * password/key stretching
          */
         const size_t PBKDF2_ITERS = 10'000;
+
+        /**
+         * Defines the maximum number of blocks of wallet sync data that will be
+         * returned by a single request
+         */
+        const size_t MAXIMUM_SYNC_DATA_BLOCKS = 1'000;
+
+        /**
+         * Defines the number of blocks of wallet sync data that are read from the
+         * database and written to the client at a time while streaming
+         */
+        const size_t SYNC_DATA_CHUNK_BLOCKS = 50;
+
+        /**
+         * Defines the default number of bytes of encoded responses that the HTTP server
+         * keeps for resources that no longer change
+         */
+        const size_t HTTP_RESPONSE_CACHE_SIZE = 64 * 1'048'576;
+
+        /**
+         * Defines the number of seconds that clients may cache responses for resources
+         * that no longer change
+         */
+        const size_t HTTP_IMMUTABLE_MAX_AGE = 31'536'000;
+
+        /**
+         * Defines the default number of worker threads that process HTTP connections,
+         * zero uses one thread per hardware thread (with a minimum of eight)
+         */
+        const size_t HTTP_WORKER_THREADS = 0;
+
+        /**
+         * Defines the default number of accepted HTTP connections that may wait for a
+         * worker thread before new connections are turned away with a 503
+         */
+        const size_t HTTP_MAXIMUM_QUEUED_CONNECTIONS = 1'024;
+
+        /**
+         * Defines the number of turned away HTTP connections that may wait for their 503,
+         * connections beyond that are closed without a response
+         */
+        const size_t HTTP_MAXIMUM_QUEUED_REJECTIONS = 256;
+
+        /**
+         * Defines the default maximum number of requests served over a single keep-alive
+         * HTTP connection before it is closed
+         */
+        const size_t HTTP_KEEP_ALIVE_MAX_COUNT = 100;
+
+        /**
+         * Defines the default number of seconds that an idle keep-alive HTTP connection
+         * is held open for
+         */
+        const size_t HTTP_KEEP_ALIVE_TIMEOUT = 5;
+
+        /**
+         * Defines the default number of seconds allowed to read a request from, or write
+         * a response to, an HTTP connection
+         */
+        const size_t HTTP_READ_TIMEOUT = 5;
+
+        const size_t HTTP_WRITE_TIMEOUT = 5;
+
+        /**
+         * Defines the default maximum number of concurrent connections that an HTTP
+         * client pool opens to a single origin
+         */
+        const size_t HTTP_CLIENT_MAXIMUM_CONNECTIONS = 8;
+
+        /**
+         * Defines the default number of seconds that an idle pooled HTTP client
+         * connection is kept for reuse before it is closed
+         */
+        const size_t HTTP_CLIENT_IDLE_TIMEOUT = 30;
+
+        /**
+         * Defines the default zlib level (1-9) used to compress HTTP responses for clients
+         * that accept a compressed encoding, zero disables compression
+         */
+        const int HTTP_COMPRESSION_LEVEL = 6;
+
+        /**
+         * Defines the default minimum number of bytes of an HTTP response body before it
+         * is compressed, smaller bodies do not gain enough to be worth the effort
+         */
+        const size_t HTTP_COMPRESSION_THRESHOLD = 1'024;
     } // namespace API
 
     namespace Consensus
@@ -189,12 +275,51 @@ namespace Configuration
          */
         const size_t ELECTOR_TARGET_COUNT = 10;
 
+        /**
+         * The number of times an elector seat is redrawn when the draw lands on a candidate
+         * that was already selected, after which the seat is drawn directly from the stake
+         * of the candidates that remain
+         */
+        const size_t ELECTOR_MAXIMUM_REDRAWS = 8;
+
         /**
          * The minimum percentage of validators in a round that must validate a block for
          * the block to be committed to the chain.
          */
         const size_t VALIDATOR_THRESHOLD = 60;
 
+        /**
+         * The maximum combined size (in bytes) of the transactions that a producer may
+         * include in a single block
+         */
+        const size_t MAXIMUM_BLOCK_SIZE = 1'048'576;
+
+        /**
+         * The maximum number of transactions that a producer may include in a single block
+         */
+        const size_t MAXIMUM_BLOCK_TRANSACTIONS = 2'000;
+
+        /**
+         * The amount of time (in milliseconds) a producer may spend assembling a block
+         * template before it must hand off the template for signing
+         */
+        const size_t BLOCK_TEMPLATE_TIME_BUDGET = 250;
+
+        /**
+         * The assume valid checkpoint. During sync the expensive cryptographic checks
+         * (block signatures and transaction proof of work) of the blocks below this
+         * block index are skipped; structural checks, key image uniqueness, and the
+         * building of the indexes still take place. The genesis block is always fully
+         * checked. A block at this index with any other hash is rejected. If the block
+         * with the specified hash does not extend the stored chain, the most recently
+         * assumed valid blocks are rewound so that they may be synced again.
+         *
+         * An empty hash disables the checkpoint
+         */
+        const uint64_t ASSUME_VALID_BLOCK_INDEX = 0;
+
+        const crypto_hash_t ASSUME_VALID_BLOCK_HASH = crypto_hash_t();
+
         /**
          * Permanent candidates injected into the election process so that in the event
          * we are unable to elect enough candidates to support the creation of new blocks.
@@ -222,6 +347,32 @@ namespace Configuration
         const uint64_t STAKE_RECORD_VERSION = 1;
     } // namespace Staking
 
+    namespace Node
+    {
+        /**
+         * The number of entries each queue between the stages of the node pipeline
+         * will hold before the upstream stage is forced to wait
+         */
+        const size_t PIPELINE_QUEUE_DEPTH = 256;
+
+        /**
+         * The maximum number of validated blocks the persist stage writes per batch
+         */
+        const size_t PIPELINE_PERSIST_BATCH = 64;
+
+        /**
+         * Defines how often the node pipeline reports per-stage throughput
+         */
+        const size_t PIPELINE_STATS_INTERVAL = 30'000; // expressed in milliseconds
+
+        /**
+         * The number of assumed valid blocks rewound the first time that the assume valid
+         * checkpoint block does not extend the stored chain; the number doubles each time
+         * that it happens again until the chain links up with the checkpoint
+         */
+        const uint64_t ASSUME_VALID_REWIND_DEPTH = 1'000;
+    } // namespace Node
+
     namespace Wallet
     {
         /**
@@ -262,6 +413,12 @@ namespace Configuration
          */
         const size_t MAXIMUM_EXTRA_SIZE = 1'024;
 
+        /**
+         * The maximum number of transactions whose successful cryptographic verification
+         * is remembered so that it is not repeated when the transaction arrives in a block
+         */
+        const size_t VERIFIED_CACHE_SIZE = 65'536;
+
         namespace Genesis
         {
             /**
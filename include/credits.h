@@ -0,0 +1,465 @@
+const auto program_credits = 
+"This product utilizes libraries and/or code provided by the following:\n"
+"\n"
+"===============================================================================\n"
+"================================ MIT Licensed =================================\n"
+"===============================================================================\n"
+"\n"
+"Argon2:             Copyright (c) 2016 Ondrej Mosnáček\n"
+"uint256_t:          Copyright (c) 2013-2017 Jason Lee <calccrypto@gmail.com>\n"
+"Emscripten:         Copyright (c) 2018 Emscripten authors\n"
+"                        (see AUTHORS in Emscripten)\n"
+"cppfs:              Copyright (c) 2017-2017 CG Internals GmbH\n"
+"cpp-httplib:        Copyright (c) 2017 yhirose\n"
+"cppzmq:             Copyright (c) The cppzmq authors\n"
+"cxxfolders:         Copyright (c) 2015 Poul Sander\n"
+"cxxopts:            Copyright (c) 2014 Jarryd Beck\n"
+"ipv6-parse:         Copyright (c) 2017-2020 jacobrepp@gmail.com\n"
+"                    Copyright (c) 2020, The TurtleCoin Developers\n"
+"RapidJSON:          Copyright (C) 2015 THL A29 Limited, a Tencent company,\n"
+"                        and Milo Yip.\n"
+"Base58:             Copyright (c) 2009-2010 Satoshi Nakamoto\n"
+"                    Copyright (c) 2014-2020 The Bitcoin Core Developers\n"
+"CNBase58:           Copyright (c) 2011-2016 The Cryptonote Developers\n"
+"spdlog:             Copyright (c) 2016 Gabi Melman\n"
+"fmt:                Copyright (c) 2012 - present, Victor Zverovich\n"
+"\n"
+"Permission is hereby granted, free of charge, to any person obtaining a copy\n"
+"of this software and associated documentation files (the \"Software\"), to deal\n"
+"in the Software without restriction, including without limitation the rights\n"
+"to use, copy, modify, merge, publish, distribute, sublicense, and/or sell\n"
+"copies of the Software, and to permit persons to whom the Software is\n"
+"furnished to do so, subject to the following conditions:\n"
+"\n"
+"The above copyright notice and this permission notice shall be included in all\n"
+"copies or substantial portions of the Software.\n"
+"\n"
+"THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\n"
+"IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\n"
+"FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\n"
+"AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER\n"
+"LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,\n"
+"OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE\n"
+"SOFTWARE.\n"
+"\n"
+"===============================================================================\n"
+"================================ BSD-2 Clause =================================\n"
+"===============================================================================\n"
+"\n"
+"cpp-linenoise:      Copyright (c) 2015 yhirose\n"
+"All rights reserved.\n"
+"\n"
+"Redistribution and use in source and binary forms, with or without\n"
+"modification, are permitted provided that the following conditions are met:\n"
+"\n"
+"1. Redistributions of source code must retain the above copyright notice, this\n"
+"   list of conditions and the following disclaimer.\n"
+"2. Redistributions in binary form must reproduce the above copyright notice,\n"
+"   this list of conditions and the following disclaimer in the documentation\n"
+"   and/or other materials provided with the distribution.\n"
+"\n"
+"THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\" AND\n"
+"ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED\n"
+"WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE\n"
+"DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR\n"
+"ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES\n"
+"(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;\n"
+"LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND\n"
+"ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT\n"
+"(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS\n"
+"SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.\n"
+"\n"
+"===============================================================================\n"
+"================================ BSD-3 Clause =================================\n"
+"===============================================================================\n"
+"\n"
+"turtlecoin-crypto:  Copyright (c) 2020-2021, The TurtleCoin Developers\n"
+"MiniUPnP Project:   Copyright (c) 2005-2020, Thomas BERNARD\n"
+"The msinttypes r29: Copyright (c) 2006-2013 Alexander Chemeris\n"
+"All rights reserved.\n"
+"\n"
+"Redistribution and use in source and binary forms, with or without\n"
+"modification, are permitted provided that the following conditions are met:\n"
+"\n"
+"    * Redistributions of source code must retain the above copyright notice,\n"
+"      this list of conditions and the following disclaimer.\n"
+"    * Redistributions in binary form must reproduce the above copyright notice,\n"
+"      this list of conditions and the following disclaimer in the documentation\n"
+"      and/or other materials provided with the distribution.\n"
+"    * The name of the author may not be used to endorse or promote products\n"
+"      derived from this software without specific prior written permission.\n"
+"\n"
+"THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n"
+"AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n"
+"IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n"
+"ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE\n"
+"LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR\n"
+"CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF\n"
+"SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS\n"
+"INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n"
+"CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)\n"
+"ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n"
+"POSSIBILITY OF SUCH DAMAGE.\n"
+"\n"
+"===============================================================================\n"
+"================================ JSON License =================================\n"
+"===============================================================================\n"
+"\n"
+"json.org:           Copyright (c) 2002 JSON.org\n"
+"JSON_checker:       Copyright (c) 2002 JSON.org\n"
+"All Rights Reserved.\n"
+"\n"
+"Permission is hereby granted, free of charge, to any person obtaining a copy of\n"
+"this software and associated documentation files (the \"Software\"), to deal in\n"
+"the Software without restriction, including without limitation the rights to\n"
+"use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies\n"
+"of the Software, and to permit persons to whom the Software is furnished to do\n"
+"so, subject to the following conditions:\n"
+"\n"
+"The above copyright notice and this permission notice shall be included in all\n"
+"copies or substantial portions of the Software.\n"
+"\n"
+"The Software shall be used for Good, not Evil.\n"
+"\n"
+"THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\n"
+"IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\n"
+"FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\n"
+"AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER\n"
+"LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,\n"
+"OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE\n"
+"SOFTWARE.\n"
+"\n"
+"===============================================================================\n"
+"===== GNU LESSER GENERAL PUBLIC LICENSE v3 w/ Static Linking Exception ========\n"
+"===============================================================================\n"
+"\n"
+"Note: ZeroMQ is licensed under the LGPLv3; however, they provide a special\n"
+"linking exception found at the end of this license copy or you can find it at\n"
+"https://github.com/zeromq/libzmq/blob/master/COPYING.LESSER\n"
+"\n"
+"libzmq\n"
+"\n"
+"                   GNU LESSER GENERAL PUBLIC LICENSE\n"
+"                       Version 3, 29 June 2007\n"
+"\n"
+" Copyright (C) 2007 Free Software Foundation, Inc. <https://fsf.org/>\n"
+" Everyone is permitted to copy and distribute verbatim copies\n"
+" of this license document, but changing it is not allowed.\n"
+"\n"
+"\n"
+"  This version of the GNU Lesser General Public License incorporates\n"
+"the terms and conditions of version 3 of the GNU General Public\n"
+"License, supplemented by the additional permissions listed below.\n"
+"\n"
+"  0. Additional Definitions.\n"
+"\n"
+"  As used herein, \"this License\" refers to version 3 of the GNU Lesser\n"
+"General Public License, and the \"GNU GPL\" refers to version 3 of the GNU\n"
+"General Public License.\n"
+"\n"
+"  \"The Library\" refers to a covered work governed by this License,\n"
+"other than an Application or a Combined Work as defined below.\n"
+"\n"
+"  An \"Application\" is any work that makes use of an interface provided\n"
+"by the Library, but which is not otherwise based on the Library.\n"
+"Defining a subclass of a class defined by the Library is deemed a mode\n"
+"of using an interface provided by the Library.\n"
+"\n"
+"  A \"Combined Work\" is a work produced by combining or linking an\n"
+"Application with the Library.  The particular version of the Library\n"
+"with which the Combined Work was made is also called the \"Linked\n"
+"Version\".\n"
+"\n"
+"  The \"Minimal Corresponding Source\" for a Combined Work means the\n"
+"Corresponding Source for the Combined Work, excluding any source code\n"
+"for portions of the Combined Work that, considered in isolation, are\n"
+"based on the Application, and not on the Linked Version.\n"
+"\n"
+"  The \"Corresponding Application Code\" for a Combined Work means the\n"
+"object code and/or source code for the Application, including any data\n"
+"and utility programs needed for reproducing the Combined Work from the\n"
+"Application, but excluding the System Libraries of the Combined Work.\n"
+"\n"
+"  1. Exception to Section 3 of the GNU GPL.\n"
+"\n"
+"  You may convey a covered work under sections 3 and 4 of this License\n"
+"without being bound by section 3 of the GNU GPL.\n"
+"\n"
+"  2. Conveying Modified Versions.\n"
+"\n"
+"  If you modify a copy of the Library, and, in your modifications, a\n"
+"facility refers to a function or data to be supplied by an Application\n"
+"that uses the facility (other than as an argument passed when the\n"
+"facility is invoked), then you may convey a copy of the modified\n"
+"version:\n"
+"\n"
+"   a) under this License, provided that you make a good faith effort to\n"
+"   ensure that, in the event an Application does not supply the\n"
+"   function or data, the facility still operates, and performs\n"
+"   whatever part of its purpose remains meaningful, or\n"
+"\n"
+"   b) under the GNU GPL, with none of the additional permissions of\n"
+"   this License applicable to that copy.\n"
+"\n"
+"  3. Object Code Incorporating Material from Library Header Files.\n"
+"\n"
+"  The object code form of an Application may incorporate material from\n"
+"a header file that is part of the Library.  You may convey such object\n"
+"code under terms of your choice, provided that, if the incorporated\n"
+"material is not limited to numerical parameters, data structure\n"
+"layouts and accessors, or small macros, inline functions and templates\n"
+"(ten or fewer lines in length), you do both of the following:\n"
+"\n"
+"   a) Give prominent notice with each copy of the object code that the\n"
+"   Library is used in it and that the Library and its use are\n"
+"   covered by this License.\n"
+"\n"
+"   b) Accompany the object code with a copy of the GNU GPL and this license\n"
+"   document.\n"
+"\n"
+"  4. Combined Works.\n"
+"\n"
+"  You may convey a Combined Work under terms of your choice that,\n"
+"taken together, effectively do not restrict modification of the\n"
+"portions of the Library contained in the Combined Work and reverse\n"
+"engineering for debugging such modifications, if you also do each of\n"
+"the following:\n"
+"\n"
+"   a) Give prominent notice with each copy of the Combined Work that\n"
+"   the Library is used in it and that the Library and its use are\n"
+"   covered by this License.\n"
+"\n"
+"   b) Accompany the Combined Work with a copy of the GNU GPL and this license\n"
+"   document.\n"
+"\n"
+"   c) For a Combined Work that displays copyright notices during\n"
+"   execution, include the copyright notice for the Library among\n"
+"   these notices, as well as a reference directing the user to the\n"
+"   copies of the GNU GPL and this license document.\n"
+"\n"
+"   d) Do one of the following:\n"
+"\n"
+"       0) Convey the Minimal Corresponding Source under the terms of this\n"
+"       License, and the Corresponding Application Code in a form\n"
+"       suitable for, and under terms that permit, the user to\n"
+"       recombine or relink the Application with a modified version of\n"
+"       the Linked Version to produce a modified Combined Work, in the\n"
+"       manner specified by section 6 of the GNU GPL for conveying\n"
+"       Corresponding Source.\n"
+"\n"
+"       1) Use a suitable shared library mechanism for linking with the\n"
+"       Library.  A suitable mechanism is one that (a) uses at run time\n"
+"       a copy of the Library already present on the user's computer\n"
+"       system, and (b) will operate properly with a modified version\n"
+"       of the Library that is interface-compatible with the Linked\n"
+"       Version.\n"
+"\n"
+"   e) Provide Installation Information, but only if you would otherwise\n"
+"   be required to provide such information under section 6 of the\n"
+"   GNU GPL, and only to the extent that such information is\n"
+"   necessary to install and execute a modified version of the\n"
+"   Combined Work produced by recombining or relinking the\n"
+"   Application with a modified version of the Linked Version. (If\n"
+"   you use option 4d0, the Installation Information must accompany\n"
+"   the Minimal Corresponding Source and Corresponding Application\n"
+"   Code. If you use option 4d1, you must provide the Installation\n"
+"   Information in the manner specified by section 6 of the GNU GPL\n"
+"   for conveying Corresponding Source.)\n"
+"\n"
+"  5. Combined Libraries.\n"
+"\n"
+"  You may place library facilities that are a work based on the\n"
+"Library side by side in a single library together with other library\n"
+"facilities that are not Applications and are not covered by this\n"
+"License, and convey such a combined library under terms of your\n"
+"choice, if you do both of the following:\n"
+"\n"
+"   a) Accompany the combined library with a copy of the same work based\n"
+"   on the Library, uncombined with any other library facilities,\n"
+"   conveyed under the terms of this License.\n"
+"\n"
+"   b) Give prominent notice with the combined library that part of it\n"
+"   is a work based on the Library, and explaining where to find the\n"
+"   accompanying uncombined form of the same work.\n"
+"\n"
+"  6. Revised Versions of the GNU Lesser General Public License.\n"
+"\n"
+"  The Free Software Foundation may publish revised and/or new versions\n"
+"of the GNU Lesser General Public License from time to time. Such new\n"
+"versions will be similar in spirit to the present version, but may\n"
+"differ in detail to address new problems or concerns.\n"
+"\n"
+"  Each version is given a distinguishing version number. If the\n"
+"Library as you received it specifies that a certain numbered version\n"
+"of the GNU Lesser General Public License \"or any later version\"\n"
+"applies to it, you have the option of following the terms and\n"
+"conditions either of that published version or of any later version\n"
+"published by the Free Software Foundation. If the Library as you\n"
+"received it does not specify a version number of the GNU Lesser\n"
+"General Public License, you may choose any version of the GNU Lesser\n"
+"General Public License ever published by the Free Software Foundation.\n"
+"\n"
+"  If the Library as you received it specifies that a proxy can decide\n"
+"whether future versions of the GNU Lesser General Public License shall\n"
+"apply, that proxy's public statement of acceptance of any version is\n"
+"permanent authorization for you to choose that version for the\n"
+"Library.\n"
+"\n"
+"--------------------------------------------------------------------------------\n"
+"\n"
+"           SPECIAL EXCEPTION GRANTED BY COPYRIGHT HOLDERS\n"
+"\n"
+"As a special exception, copyright holders give you permission to link this\n"
+"library with independent modules to produce an executable, regardless of\n"
+"the license terms of these independent modules, and to copy and distribute\n"
+"the resulting executable under terms of your choice, provided that you also\n"
+"meet, for each linked independent module, the terms and conditions of\n"
+"the license of that module. An independent module is a module which is not\n"
+"derived from or based on this library. If you modify this library, you must\n"
+"extend this exception to your version of the library.\n"
+"\n"
+"Note: this exception relieves you of any obligations under sections 4 and 5\n"
+"of this license, and section 6 of the GNU General Public License.\n"
+"\n"
+"===============================================================================\n"
+"====================== The OpenLDAP Public License v2.8 =======================\n"
+"===============================================================================\n"
+"\n"
+"LMDB\n"
+"\n"
+"The OpenLDAP Public License\n"
+"  Version 2.8, 17 August 2003\n"
+"\n"
+"Redistribution and use of this software and associated documentation\n"
+"(\"Software\"), with or without modification, are permitted provided\n"
+"that the following conditions are met:\n"
+"\n"
+"1. Redistributions in source form must retain copyright statements\n"
+"   and notices,\n"
+"\n"
+"2. Redistributions in binary form must reproduce applicable copyright\n"
+"   statements and notices, this list of conditions, and the following\n"
+"   disclaimer in the documentation and/or other materials provided\n"
+"   with the distribution, and\n"
+"\n"
+"3. Redistributions must contain a verbatim copy of this document.\n"
+"\n"
+"The OpenLDAP Foundation may revise this license from time to time.\n"
+"Each revision is distinguished by a version number.  You may use\n"
+"this Software under terms of this license revision or under the\n"
+"terms of any subsequent revision of the license.\n"
+"\n"
+"THIS SOFTWARE IS PROVIDED BY THE OPENLDAP FOUNDATION AND ITS\n"
+"CONTRIBUTORS ``AS IS'' AND ANY EXPRESSED OR IMPLIED WARRANTIES,\n"
+"INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY\n"
+"AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT\n"
+"SHALL THE OPENLDAP FOUNDATION, ITS CONTRIBUTORS, OR THE AUTHOR(S)\n"
+"OR OWNER(S) OF THE SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,\n"
+"INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,\n"
+"BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;\n"
+"LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER\n"
+"CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT\n"
+"LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN\n"
+"ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n"
+"POSSIBILITY OF SUCH DAMAGE.\n"
+"\n"
+"The names of the authors and copyright holders must not be used in\n"
+"advertising or otherwise to promote the sale, use or other dealing\n"
+"in this Software without specific, written prior permission.  Title\n"
+"to copyright in this Software shall at all times remain with copyright\n"
+"holders.\n"
+"\n"
+"OpenLDAP is a registered trademark of the OpenLDAP Foundation.\n"
+"\n"
+"Copyright 1999-2003 The OpenLDAP Foundation, Redwood City,\n"
+"California, USA.  All Rights Reserved.  Permission to copy and\n"
+"distribute verbatim copies of this document is granted.\n"
+"\n"
+"===============================================================================\n"
+"======================= Crypto++ Licensing Information ========================\n"
+"===============================================================================\n"
+"\n"
+"Compilation Copyright (c) 1995-2019 by Wei Dai.  All rights reserved.\n"
+"This copyright applies only to this software distribution package\n"
+"as a compilation, and does not imply a copyright on any particular\n"
+"file in the package.\n"
+"\n"
+"All individual files in this compilation are placed in the public domain by\n"
+"Wei Dai and other contributors.\n"
+"\n"
+"I would like to thank the following authors for placing their works into\n"
+"the public domain:\n"
+"\n"
+"Joan Daemen - 3way.cpp\n"
+"Leonard Janke - cast.cpp, seal.cpp\n"
+"Steve Reid - cast.cpp\n"
+"Phil Karn - des.cpp\n"
+"Andrew M. Kuchling - md2.cpp, md4.cpp\n"
+"Colin Plumb - md5.cpp\n"
+"Seal Woods - rc6.cpp\n"
+"Chris Morgan - rijndael.cpp\n"
+"Paulo Baretto - rijndael.cpp, skipjack.cpp, square.cpp\n"
+"Richard De Moliner - safer.cpp\n"
+"Matthew Skala - twofish.cpp\n"
+"Kevin Springle - camellia.cpp, shacal2.cpp, ttmac.cpp, whrlpool.cpp, ripemd.cpp\n"
+"Ronny Van Keer - sha3.cpp\n"
+"Aumasson, Neves, Wilcox-O'Hearn and Winnerlein - blake2.cpp, blake2b_simd.cpp, blake2s_simd.cpp\n"
+"Aaram Yun - aria.cpp, aria_simd.cpp\n"
+"Han Lulu, Markku-Juhani O. Saarinen - sm4.cpp sm4_simd.cpp\n"
+"Daniel J. Bernstein, Jack Lloyd - chacha.cpp, chacha_simd.cpp, chacha_avx.cpp\n"
+"Andrew Moon - ed25519, x25519, donna_32.cpp, donna_64.cpp, donna_sse.cpp\n"
+"\n"
+"The Crypto++ Library uses portions of Andy Polyakov's CRYPTOGAMS for Poly1305\n"
+"scalar multiplication, aes_armv4.S, sha1_armv4.S and sha256_armv4.S. CRYPTOGAMS\n"
+"is dual licensed with a permissive BSD-style license. The CRYPTOGAMS license is\n"
+"reproduced below.\n"
+"\n"
+"The Crypto++ Library uses portions of Jack Lloyd's Botan for ChaCha SSE2 and\n"
+"AVX. Botan placed the code in public domain for Crypto++ to use.\n"
+"\n"
+"The Crypto++ Library (as a compilation) is currently licensed under the Boost\n"
+"Software License 1.0 (http://www.boost.org/users/license.html).\n"
+"\n"
+"Boost Software License - Version 1.0 - August 17th, 2003\n"
+"\n"
+"Permission is hereby granted, free of charge, to any person or organization\n"
+"obtaining a copy of the software and accompanying documentation covered by\n"
+"this license (the \"Software\") to use, reproduce, display, distribute,\n"
+"execute, and transmit the Software, and to prepare derivative works of the\n"
+"Software, and to permit third-parties to whom the Software is furnished to\n"
+"do so, all subject to the following:\n"
+"\n"
+"The copyright notices in the Software and this entire statement, including\n"
+"the above license grant, this restriction and the following disclaimer,\n"
+"must be included in all copies of the Software, in whole or in part, and\n"
+"all derivative works of the Software, unless such copies or derivative\n"
+"works are solely in the form of machine-executable object code generated by\n"
+"a source language processor.\n"
+"\n"
+"THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\n"
+"IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\n"
+"FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT\n"
+"SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE\n"
+"FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,\n"
+"ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER\n"
+"DEALINGS IN THE SOFTWARE.\n"
+"\n"
+"CRYPTOGAMS License\n"
+"\n"
+"Copyright (c) 2006-2017, CRYPTOGAMS by <appro@openssl.org>\n"
+"All rights reserved.\n"
+"\n"
+"Redistribution and use in source and binary forms, with or without\n"
+"modification, are permitted provided that the following conditions\n"
+"are met:\n"
+"\n"
+"* Redistributions of source code must retain copyright notices,\n"
+"  this list of conditions and the following disclaimer.\n"
+"* Redistributions in binary form must reproduce the above\n"
+"  copyright notice, this list of conditions and the following\n"
+"  disclaimer in the documentation and/or other materials\n"
+"  provided with the distribution.\n"
+"* Neither the name of the CRYPTOGAMS nor the names of its copyright\n"
+"  holder and contributors may be used to endorse or promote products\n"
+"  derived from this software without specific prior written permission.\n"
+"";
\ No newline at end of file
@@ -18,7 +18,8 @@ namespace BaseTypes
         NETWORK_HANDSHAKE = 1000,
         NETWORK_KEEPALIVE = 1100,
         NETWORK_PEER_EXCHANGE = 1200,
-        NETWORK_DATA = 3000
+        NETWORK_DATA = 3000,
+        NETWORK_BLOCK = 3100
     };
 
     struct NetworkPacketBase
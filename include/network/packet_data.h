@@ -16,6 +16,17 @@ namespace Types::Network
             l_type = BaseTypes::NETWORK_DATA;
         }
 
+        /**
+         * Creates a data packet of the specified type, e.g. NETWORK_BLOCK for a block
+         * and its transactions
+         *
+         * @param type
+         */
+        packet_data_t(BaseTypes::NetworkPacketTypes type)
+        {
+            l_type = type;
+        }
+
         packet_data_t(deserializer_t &reader)
         {
             deserialize(reader);
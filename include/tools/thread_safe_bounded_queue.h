@@ -0,0 +1,197 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_THREAD_SAFE_BOUNDED_QUEUE_H
+#define TURTLECOIN_THREAD_SAFE_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/**
+ * A fixed capacity queue used to connect the stages of a pipeline
+ *
+ * Producers block while the queue is full (backpressure) and consumers block while
+ * the queue is empty. Closing the queue wakes all waiters; any items remaining in
+ * the queue may still be popped after the queue has been closed.
+ */
+template<typename T> class ThreadSafeBoundedQueue
+{
+  public:
+    ThreadSafeBoundedQueue(size_t capacity): m_capacity(capacity == 0 ? 1 : capacity) {}
+
+    /**
+     * Returns the maximum number of elements the queue will hold
+     *
+     * @return
+     */
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * Closes the queue and wakes all waiting producers and consumers
+     */
+    void close()
+    {
+        {
+            std::unique_lock lock(m_mutex);
+
+            m_closed = true;
+        }
+
+        m_not_empty.notify_all();
+
+        m_not_full.notify_all();
+    }
+
+    /**
+     * Returns whether the queue has been closed
+     *
+     * @return
+     */
+    bool closed() const
+    {
+        std::unique_lock lock(m_mutex);
+
+        return m_closed;
+    }
+
+    /**
+     * Removes the first element in the queue, waiting until one is available
+     *
+     * Returns (FALSE) if the queue was closed and is empty
+     *
+     * @param item
+     * @return
+     */
+    bool pop(T &item)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+
+            m_not_empty.wait(lock, [this] { return !m_container.empty() || m_closed; });
+
+            if (m_container.empty())
+            {
+                return false;
+            }
+
+            item = std::move(m_container.front());
+
+            m_container.pop_front();
+        }
+
+        m_not_full.notify_one();
+
+        return true;
+    }
+
+    /**
+     * Waits until at least one element is available and then removes up to the
+     * maximum number of elements from the front of the queue
+     *
+     * Returns the number of elements removed, zero if the queue was closed and is empty
+     *
+     * @param items
+     * @param maximum
+     * @return
+     */
+    size_t pop(std::vector<T> &items, size_t maximum)
+    {
+        size_t count = 0;
+
+        {
+            std::unique_lock lock(m_mutex);
+
+            m_not_empty.wait(lock, [this] { return !m_container.empty() || m_closed; });
+
+            while (!m_container.empty() && count < maximum)
+            {
+                items.push_back(std::move(m_container.front()));
+
+                m_container.pop_front();
+
+                count++;
+            }
+        }
+
+        m_not_full.notify_all();
+
+        return count;
+    }
+
+    /**
+     * Adds the element to the end of the queue, waiting while the queue is full
+     *
+     * Returns (FALSE) if the queue was closed before the element could be added
+     *
+     * @param item
+     * @return
+     */
+    bool push(T item)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+
+            if (m_container.size() >= m_capacity && !m_closed)
+            {
+                m_stalls++;
+
+                m_not_full.wait(lock, [this] { return m_container.size() < m_capacity || m_closed; });
+            }
+
+            if (m_closed)
+            {
+                return false;
+            }
+
+            m_container.push_back(std::move(item));
+        }
+
+        m_not_empty.notify_one();
+
+        return true;
+    }
+
+    /**
+     * Returns the size of the queue
+     *
+     * @return
+     */
+    size_t size() const
+    {
+        std::unique_lock lock(m_mutex);
+
+        return m_container.size();
+    }
+
+    /**
+     * Returns the number of times a producer had to wait because the queue was full
+     *
+     * @return
+     */
+    size_t stalls() const
+    {
+        return m_stalls;
+    }
+
+  private:
+    std::deque<T> m_container;
+
+    size_t m_capacity;
+
+    bool m_closed = false;
+
+    std::atomic<size_t> m_stalls = 0;
+
+    std::condition_variable m_not_empty, m_not_full;
+
+    mutable std::mutex m_mutex;
+};
+
+#endif
@@ -9,6 +9,7 @@
 
 // Block
 #include "blockchain/block.h"
+#include "blockchain/block_sync_data.h"
 
 // Network Transactions
 #include "blockchain/transaction_genesis.h"
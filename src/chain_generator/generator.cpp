@@ -0,0 +1,143 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include <chain_generator.h>
+#include <chrono>
+#include <cli_helper.h>
+#include <cppfs/FileHandle.h>
+#include <cppfs/fs.h>
+#include <logger.h>
+
+int main(int argc, char **argv)
+{
+    auto cli = std::make_shared<Utilities::CLIHelper>(argv);
+
+    Core::chain_generator_config_t config;
+
+    uint64_t height = 10'000;
+
+    bool reset_db = false;
+
+    std::string db_path = "./synthetic-chain", log_path;
+
+    // clang-format off
+    cli->add_options("Chain Generator")
+        ("d,db-path", "Specify the <path> to the directory the synthetic chain is written to",
+            cxxopts::value<std::string>(db_path)->default_value(db_path), "<path>")
+        ("height", "The number of blocks to generate",
+            cxxopts::value<uint64_t>(height)->default_value(std::to_string(height)), "#")
+        ("mine", "Mine the proof of work of every transaction (approximately one second per transaction)",
+            cxxopts::value<bool>(config.mine)->implicit_value("true"))
+        ("reset", "Remove an existing chain from the database directory before generating",
+            cxxopts::value<bool>(reset_db)->implicit_value("true"))
+        ("seed", "The seed that the chain is generated from",
+            cxxopts::value<uint64_t>(config.seed)->default_value(std::to_string(config.seed)), "#")
+        ("transactions", "The number of transactions in each block",
+            cxxopts::value<size_t>(config.transactions_per_block)
+                ->default_value(std::to_string(config.transactions_per_block)), "#");
+
+    cli->add_options("Transaction Mix")
+        ("normal-weight", "The relative weight of normal transactions",
+            cxxopts::value<size_t>(config.normal_weight)->default_value(std::to_string(config.normal_weight)), "#")
+        ("stake-weight", "The relative weight of stake transactions",
+            cxxopts::value<size_t>(config.stake_weight)->default_value(std::to_string(config.stake_weight)), "#")
+        ("recall-weight", "The relative weight of recall stake transactions",
+            cxxopts::value<size_t>(config.recall_stake_weight)
+                ->default_value(std::to_string(config.recall_stake_weight)), "#");
+    // clang-format on
+
+    cli->parse(argc, argv);
+
+    cli->argument_load("log-file", log_path);
+
+    auto logger = Logger::create_logger(log_path, cli->log_level());
+
+    if (config.normal_weight + config.stake_weight + config.recall_stake_weight == 0)
+    {
+        logger->error("At least one transaction type must have a weight greater than zero");
+
+        exit(1);
+    }
+
+    const auto database_path = cli->get_db_path(db_path, "chain");
+
+    if (reset_db)
+    {
+        try
+        {
+            auto directory = cppfs::fs::open(database_path.toNative());
+
+            if (directory.isDirectory())
+            {
+                directory.removeDirectoryRec();
+            }
+
+            logger->info("Reset Synthetic Chain Database");
+        }
+        catch (const std::exception &e)
+        {
+            logger->error("Could not reset Synthetic Chain Database: {0}", e.what());
+
+            exit(1);
+        }
+    }
+
+    auto storage = Core::BlockchainStorage::instance(database_path.path());
+
+    logger->info(
+        "Generating {0} blocks of {1} transactions with seed {2}",
+        height,
+        config.transactions_per_block,
+        config.seed);
+
+    // the point pools are derived from the seed when the generator is constructed
+    Core::ChainGenerator generator(config);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto elapsed_seconds = [&start]()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const auto error = generator.generate(
+        storage,
+        height,
+        [&](uint64_t blocks)
+        {
+            logger->info(
+                "Wrote {0}/{1} blocks ({2} transactions, {3} outputs, {4} key images) in {5:.1f}s",
+                blocks,
+                height,
+                generator.transaction_count(),
+                generator.output_count(),
+                generator.key_image_count(),
+                elapsed_seconds());
+        });
+
+    if (error)
+    {
+        logger->error("Could not generate the synthetic chain: {0}", error.to_string());
+
+        if (error == DB_NOT_EMPTY)
+        {
+            logger->error("Use --reset to replace the existing chain");
+        }
+
+        exit(1);
+    }
+
+    const auto elapsed = elapsed_seconds();
+
+    logger->info(
+        "Generated {0} blocks in {1:.1f}s ({2:.1f} blocks/s, {3:.1f} transactions/s)",
+        height,
+        elapsed,
+        height / std::max(elapsed, 0.001),
+        generator.transaction_count() / std::max(elapsed, 0.001));
+
+    logger->info("The database now contains {0} transaction outputs", storage->output_count());
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "pow_miner.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace Common::ProofOfWork
+{
+    std::tuple<bool, uint64_t, crypto_hash_t> mine(
+        const std::vector<uint8_t> &head,
+        const std::vector<uint8_t> &tail,
+        uint8_t zeros,
+        size_t threads)
+    {
+        threads = std::max<size_t>(threads, 1);
+
+        // the lowest nonce found so far, UINT64_MAX while nothing has been found
+        std::atomic<uint64_t> best = UINT64_MAX;
+
+        crypto_hash_t best_hash;
+
+        std::mutex best_mutex;
+
+        const auto worker = [&](uint64_t start)
+        {
+            std::vector<uint8_t> buffer(head);
+
+            size_t nonce_size = 0;
+
+            for (uint64_t nonce = start; nonce < best; nonce += threads)
+            {
+                serializer_t encoded;
+
+                encoded.varint(nonce);
+
+                if (encoded.size() == nonce_size)
+                {
+                    // patch the nonce in place
+                    std::memcpy(buffer.data() + head.size(), encoded.data(), encoded.size());
+                }
+                else
+                {
+                    // the varint grew, rebuild everything that follows the head
+                    buffer.resize(head.size());
+
+                    buffer.insert(buffer.end(), encoded.data(), encoded.data() + encoded.size());
+
+                    buffer.insert(buffer.end(), tail.begin(), tail.end());
+
+                    nonce_size = encoded.size();
+                }
+
+                const auto data = Crypto::Hashing::sha3(buffer.data(), buffer.size());
+
+                const auto hash = Crypto::Hashing::argon2id(
+                    data,
+                    Configuration::Transaction::ProofOfWork::ITERATIONS,
+                    Configuration::Transaction::ProofOfWork::MEMORY,
+                    Configuration::Transaction::ProofOfWork::THREADS);
+
+                if (hash.leading_zeros() >= zeros)
+                {
+                    std::scoped_lock lock(best_mutex);
+
+                    if (nonce < best)
+                    {
+                        best = nonce;
+
+                        best_hash = hash;
+                    }
+
+                    break;
+                }
+
+                // do not wrap around the nonce space
+                if (UINT64_MAX - nonce < threads)
+                {
+                    break;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+
+        for (size_t i = 1; i < threads; ++i)
+        {
+            workers.emplace_back(worker, i);
+        }
+
+        worker(0);
+
+        for (auto &thread : workers)
+        {
+            thread.join();
+        }
+
+        if (best == UINT64_MAX)
+        {
+            return {false, 0, {}};
+        }
+
+        return {true, best, best_hash};
+    }
+} // namespace Common::ProofOfWork
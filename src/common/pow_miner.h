@@ -0,0 +1,90 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef COMMON_POW_MINER_H
+#define COMMON_POW_MINER_H
+
+#include <config.h>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace Common::ProofOfWork
+{
+    /**
+     * Searches for the lowest nonce that results in a proof of work hash with at least the
+     * specified number of leading zeros
+     *
+     * The proof of work input is the transaction digest (which contains the varint encoded
+     * nonce) followed by the range proof hash. The input is provided in two parts: the bytes
+     * that precede the nonce (head) and the bytes that follow it (tail). Each worker thread
+     * holds its own copy of the input and patches the nonce in place for every attempt. The
+     * nonce space is interleaved across the threads and the search stops as soon as no lower
+     * nonce can be found, so the result is the same regardless of the number of threads.
+     *
+     * @param head
+     * @param tail
+     * @param zeros
+     * @param threads
+     * @return [found, nonce, pow hash]
+     */
+    std::tuple<bool, uint64_t, crypto_hash_t> mine(
+        const std::vector<uint8_t> &head,
+        const std::vector<uint8_t> &tail,
+        uint8_t zeros,
+        size_t threads = std::thread::hardware_concurrency());
+
+    /**
+     * Mines the transaction using the specified number of threads and sets the resulting nonce
+     *
+     * The transaction is serialized once and split around the nonce rather than being
+     * serialized again for every attempt
+     *
+     * @tparam T an uncommitted transaction type
+     * @param transaction
+     * @param zeros
+     * @param threads
+     * @return whether a nonce was found
+     */
+    template<typename T>
+    bool mine_transaction(T &transaction, uint8_t zeros, size_t threads = std::thread::hardware_concurrency())
+    {
+        if (transaction.pow_verify(zeros))
+        {
+            return true;
+        }
+
+        serializer_t prefix, nonce;
+
+        transaction.serialize_prefix(prefix);
+
+        nonce.varint(transaction.nonce);
+
+        const auto digest = transaction.serialize_digest();
+
+        // the nonce is the first field that follows the prefix
+        const std::vector<uint8_t> head(digest.begin(), digest.begin() + prefix.size());
+
+        std::vector<uint8_t> tail(digest.begin() + prefix.size() + nonce.size(), digest.end());
+
+        {
+            serializer_t writer;
+
+            writer.key(transaction.range_proof_hash());
+
+            tail.insert(tail.end(), writer.data(), writer.data() + writer.size());
+        }
+
+        const auto [found, result, hash] = mine(head, tail, zeros, threads);
+
+        if (found)
+        {
+            transaction.nonce = result;
+        }
+
+        return found;
+    }
+} // namespace Common::ProofOfWork
+
+#endif // COMMON_POW_MINER_H
@@ -0,0 +1,226 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "block_builder.h"
+
+namespace Core
+{
+    BlockBuilder::BlockBuilder(std::shared_ptr<BlockchainStorage> &db): m_blockchain_storage(db) {}
+
+    Error BlockBuilder::add_transaction(const uncommitted_transaction_t &transaction)
+    {
+        // the committed form is built once here rather than each time that a template is built
+        const auto [txn_hash, fee, key_images, committed, size] = std::visit(
+            [](auto &&arg)
+            {
+                const auto committed = arg.to_committed();
+
+                return std::make_tuple(
+                    arg.hash(), arg.fee, arg.key_images, transaction_t(committed), committed.size());
+            },
+            transaction);
+
+        if (m_blockchain_storage->key_image_exists(key_images))
+        {
+            return MAKE_ERROR(TX_KEY_IMAGE_ALREADY_EXISTS);
+        }
+
+        std::scoped_lock lock(m_mutex);
+
+        if (m_transactions.find(txn_hash) != m_transactions.end())
+        {
+            return MAKE_ERROR(SUCCESS);
+        }
+
+        for (const auto &key_image : key_images)
+        {
+            if (m_key_images.find(key_image) != m_key_images.end())
+            {
+                return MAKE_ERROR(TX_KEY_IMAGE_PENDING);
+            }
+        }
+
+        pending_transaction_t pending;
+
+        pending.hash = txn_hash;
+
+        pending.fee = fee;
+
+        pending.size = size;
+
+        m_by_fee_rate.insert(pending);
+
+        m_transactions.insert({txn_hash, {pending, committed}});
+
+        for (const auto &key_image : key_images)
+        {
+            m_key_images.insert({key_image, txn_hash});
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    std::tuple<Error, block_t, std::vector<transaction_t>>
+        BlockBuilder::build(uint64_t timestamp, std::chrono::milliseconds time_budget)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + time_budget;
+
+        block_t block;
+
+        /**
+         * The block lists transactions in hash order, so we collect the selected
+         * transactions into a map keyed by hash as we go
+         */
+        std::map<crypto_hash_t, transaction_t> selected;
+
+        {
+            std::scoped_lock lock(m_mutex);
+
+            if (!m_prepared)
+            {
+                return {MAKE_ERROR(BLOCK_TEMPLATE_NOT_PREPARED), {}, {}};
+            }
+
+            block = *m_prepared;
+
+            block.timestamp = timestamp;
+
+            size_t block_size = 0;
+
+            for (const auto &pending : m_by_fee_rate)
+            {
+                if (selected.size() >= Configuration::Consensus::MAXIMUM_BLOCK_TRANSACTIONS
+                    || std::chrono::steady_clock::now() >= deadline)
+                {
+                    break;
+                }
+
+                // a smaller transaction further down may still fit
+                if (block_size + pending.size > Configuration::Consensus::MAXIMUM_BLOCK_SIZE)
+                {
+                    continue;
+                }
+
+                const auto &[entry, transaction] = m_transactions.at(pending.hash);
+
+                selected.insert({pending.hash, transaction});
+
+                block_size += pending.size;
+            }
+        }
+
+        std::vector<transaction_t> transactions;
+
+        for (const auto &[txn_hash, transaction] : selected)
+        {
+            block.append_transaction_hash(txn_hash);
+
+            transactions.push_back(transaction);
+        }
+
+        return {MAKE_ERROR(SUCCESS), block, transactions};
+    }
+
+    std::tuple<Error, block_t, std::vector<transaction_t>> BlockBuilder::build(
+        const crypto_hash_t &previous_blockhash,
+        uint64_t block_index,
+        uint64_t timestamp,
+        const block_transaction_t &reward_tx,
+        std::chrono::milliseconds time_budget)
+    {
+        prepare(previous_blockhash, block_index, reward_tx);
+
+        return build(timestamp, time_budget);
+    }
+
+    void BlockBuilder::prepare(
+        const crypto_hash_t &previous_blockhash,
+        uint64_t block_index,
+        const block_transaction_t &reward_tx)
+    {
+        block_t block;
+
+        block.previous_blockhash = previous_blockhash;
+
+        block.block_index = block_index;
+
+        block.reward_tx = reward_tx;
+
+        std::scoped_lock lock(m_mutex);
+
+        m_prepared = block;
+    }
+
+    void BlockBuilder::remove(const crypto_hash_t &txn_hash)
+    {
+        if (m_transactions.find(txn_hash) == m_transactions.end())
+        {
+            return;
+        }
+
+        const auto [pending, transaction] = m_transactions.at(txn_hash);
+
+        std::visit(
+            [this](auto &&arg)
+            {
+                USEVARIANT(T, arg);
+
+                if COMMITED_USER_TX_VARIANT (T)
+                {
+                    for (const auto &key_image : arg.key_images)
+                    {
+                        m_key_images.erase(key_image);
+                    }
+                }
+            },
+            transaction);
+
+        m_by_fee_rate.erase(pending);
+
+        m_transactions.erase(txn_hash);
+    }
+
+    void BlockBuilder::remove_transaction(const crypto_hash_t &txn_hash)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        remove(txn_hash);
+    }
+
+    void BlockBuilder::remove_transactions(const std::vector<transaction_t> &transactions)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        for (const auto &transaction : transactions)
+        {
+            std::visit(
+                [this](auto &&arg)
+                {
+                    USEVARIANT(T, arg);
+
+                    remove(arg.hash());
+
+                    if COMMITED_USER_TX_VARIANT (T)
+                    {
+                        // drop any pending transactions that spend the same key images
+                        for (const auto &key_image : arg.key_images)
+                        {
+                            if (m_key_images.find(key_image) != m_key_images.end())
+                            {
+                                remove(m_key_images.at(key_image));
+                            }
+                        }
+                    }
+                },
+                transaction);
+        }
+    }
+
+    size_t BlockBuilder::size() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_transactions.size();
+    }
+} // namespace Core
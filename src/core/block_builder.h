@@ -0,0 +1,174 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef CORE_BLOCK_BUILDER_H
+#define CORE_BLOCK_BUILDER_H
+
+#include "blockchain_storage.h"
+
+#include <chrono>
+#include <config.h>
+#include <errors.h>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <types.h>
+
+using namespace Types::Blockchain;
+
+namespace Core
+{
+    /**
+     * Assembles block templates for producers from the pending transactions
+     *
+     * Pending transactions are converted to their committed form when they arrive and
+     * are kept in a set ordered by fee rate (fee per committed byte) that is updated as
+     * transactions arrive and as blocks are committed. Key image
+     * uniqueness is enforced when a transaction is added so that building a template
+     * is a single walk of the ordered set that stops at the size, count, or time
+     * limit, whichever comes first.
+     */
+    class BlockBuilder
+    {
+      public:
+        BlockBuilder(std::shared_ptr<BlockchainStorage> &db);
+
+        /**
+         * Adds the transaction to the set of candidate transactions
+         *
+         * The transaction is rejected if any of its key images already exist in the
+         * database or are used by another pending transaction
+         *
+         * @param transaction
+         * @return
+         */
+        Error add_transaction(const uncommitted_transaction_t &transaction);
+
+        /**
+         * Assembles a block template from the highest fee rate pending transactions
+         * on top of the template prepared via prepare()
+         *
+         * The transactions are returned in the same order as they are listed in the
+         * block, as required by BlockchainStorage::put_block
+         *
+         * @param timestamp
+         * @param time_budget
+         * @return [error, block, transactions]
+         */
+        std::tuple<Error, block_t, std::vector<transaction_t>> build(
+            uint64_t timestamp,
+            std::chrono::milliseconds time_budget =
+                std::chrono::milliseconds(Configuration::Consensus::BLOCK_TEMPLATE_TIME_BUDGET));
+
+        /**
+         * Prepares the template and then assembles it (see prepare() and build())
+         *
+         * @param previous_blockhash
+         * @param block_index
+         * @param timestamp
+         * @param reward_tx
+         * @param time_budget
+         * @return [error, block, transactions]
+         */
+        std::tuple<Error, block_t, std::vector<transaction_t>> build(
+            const crypto_hash_t &previous_blockhash,
+            uint64_t block_index,
+            uint64_t timestamp,
+            const block_transaction_t &reward_tx,
+            std::chrono::milliseconds time_budget =
+                std::chrono::milliseconds(Configuration::Consensus::BLOCK_TEMPLATE_TIME_BUDGET));
+
+        /**
+         * Prepares the parts of the next block template that are known before the production
+         * slot begins (the previous block, the block index, and the reward transaction) so that
+         * building the template within the slot only selects the transactions
+         *
+         * @param previous_blockhash
+         * @param block_index
+         * @param reward_tx
+         */
+        void prepare(
+            const crypto_hash_t &previous_blockhash,
+            uint64_t block_index,
+            const block_transaction_t &reward_tx);
+
+        /**
+         * Removes the transaction from the set of candidate transactions
+         *
+         * @param txn_hash
+         */
+        void remove_transaction(const crypto_hash_t &txn_hash);
+
+        /**
+         * Removes the committed transactions, and any pending transactions that spend
+         * the same key images, from the set of candidate transactions
+         *
+         * @param transactions
+         */
+        void remove_transactions(const std::vector<transaction_t> &transactions);
+
+        /**
+         * Returns the number of candidate transactions
+         *
+         * @return
+         */
+        [[nodiscard]] size_t size() const;
+
+      private:
+        struct pending_transaction_t
+        {
+            crypto_hash_t hash;
+
+            uint64_t fee = 0;
+
+            // the size of the committed transaction as it is stored in the block
+            size_t size = 0;
+
+            /**
+             * Orders by fee rate descending (without division) then by hash, the products
+             * are 128-bit so that large fees cannot overflow
+             *
+             * @param other
+             * @return
+             */
+            bool operator<(const pending_transaction_t &other) const
+            {
+                const auto left = static_cast<unsigned __int128>(fee) * other.size,
+                           right = static_cast<unsigned __int128>(other.fee) * size;
+
+                if (left != right)
+                {
+                    return left > right;
+                }
+
+                return hash < other.hash;
+            }
+        };
+
+        /**
+         * Removes the transaction from the candidate set and indexes; must be called
+         * while holding the mutex
+         *
+         * @param txn_hash
+         */
+        void remove(const crypto_hash_t &txn_hash);
+
+        std::shared_ptr<BlockchainStorage> m_blockchain_storage;
+
+        std::set<pending_transaction_t> m_by_fee_rate;
+
+        // the committed form of each pending transaction
+        std::map<crypto_hash_t, std::tuple<pending_transaction_t, transaction_t>> m_transactions;
+
+        std::map<crypto_key_image_t, crypto_hash_t> m_key_images;
+
+        // the template prepared for the next block
+        std::optional<block_t> m_prepared;
+
+        mutable std::mutex m_mutex;
+    };
+} // namespace Core
+
+#endif // CORE_BLOCK_BUILDER_H
@@ -4,27 +4,73 @@
 
 #include "blockchain_storage.h"
 
+#include <atomic>
+#include <thread>
+
+#define MIGRATION_BATCH_BLOCKS 1'000
+#define PREPARE_TRANSACTIONS_PER_THREAD 64
+
 static ThreadSafeMap<crypto_hash_t, std::shared_ptr<Core::BlockchainStorage>> instances;
 
+/**
+ * Builds the key of a transaction or output from the block index and its position within the block,
+ * both are big-endian so that the rows of a block sort together and in order
+ */
+static inline serializer_t position_key(uint64_t block_index, uint32_t position)
+{
+    serializer_t writer;
+
+    writer.uint64(block_index, true);
+
+    writer.uint32(position, true);
+
+    return writer;
+}
+
 namespace Core
 {
     BlockchainStorage::BlockchainStorage(const std::string &db_path)
     {
         m_id = Crypto::Hashing::sha3(db_path.data(), db_path.size());
 
-        m_db_env = Database::LMDB::instance(db_path, 0, 0600, 16, 8);
+        m_db_env = Database::LMDB::instance(db_path, 0, 0600, 16, 16);
+
+        // the tables keyed by block index or timestamp are rebuilt with integer keys if they were created without
+        for (const auto &name : {"block_indexes", "block_timestamps", "sync_data"})
+        {
+            const auto error = m_db_env->migrate_database(name, MDB_INTEGERKEY);
+
+            if (error)
+            {
+                throw std::runtime_error("Could not migrate " + std::string(name) + ": " + error.to_string());
+            }
+        }
 
         m_blocks = m_db_env->open_database("blocks");
 
-        m_block_indexes = m_db_env->open_database("block_indexes");
+        m_block_indexes = m_db_env->open_database("block_indexes", MDB_INTEGERKEY);
 
-        m_block_timestamps = m_db_env->open_database("block_timestamps");
+        m_block_timestamps = m_db_env->open_database("block_timestamps", MDB_INTEGERKEY);
 
-        m_transactions = m_db_env->open_database("transactions");
+        m_block_transactions = m_db_env->open_database("block_transactions");
+
+        m_transaction_hashes = m_db_env->open_database("transaction_hashes");
 
         m_key_images = m_db_env->open_database("key_images");
 
-        m_transaction_outputs = m_db_env->open_database("transaction_outputs");
+        m_block_outputs = m_db_env->open_database("block_outputs");
+
+        m_output_hashes = m_db_env->open_database("output_hashes");
+
+        m_sync_data = m_db_env->open_database("sync_data", MDB_INTEGERKEY);
+
+        // the transactions and outputs of databases that stored them keyed by hash are moved to the new layout
+        const auto error = migrate_transactions();
+
+        if (error)
+        {
+            throw std::runtime_error("Could not migrate transactions: " + error.to_string());
+        }
     }
 
     BlockchainStorage::~BlockchainStorage()
@@ -45,6 +91,94 @@ namespace Core
         return m_block_indexes->exists(block_index);
     }
 
+    block_sync_data_t
+        BlockchainStorage::build_sync_data(const block_t &block, const std::vector<transaction_t> &transactions)
+    {
+        block_sync_data_t sync_data;
+
+        sync_data.block_index = block.block_index;
+
+        sync_data.block_hash = block.hash();
+
+        sync_data.timestamp = block.timestamp;
+
+        const auto append = [&sync_data](auto &&tx)
+        {
+            USEVARIANT(T, tx);
+
+            // staker outputs are credited to stakers by the staking engine and are not scanned by wallets
+            if VARIANT (T, staker_transaction_t)
+            {
+                return;
+            }
+            else
+            {
+                transaction_sync_data_t txn;
+
+                txn.txn_hash = tx.hash();
+
+                txn.unlock_block = tx.unlock_block;
+
+                txn.public_key = tx.public_key;
+
+                if COMMITED_USER_TX_VARIANT (T)
+                {
+                    txn.key_images = tx.key_images;
+                }
+
+                txn.outputs = tx.outputs;
+
+                sync_data.transactions.push_back(txn);
+            }
+        };
+
+        std::visit(append, block.reward_tx);
+
+        for (const auto &transaction : transactions)
+        {
+            std::visit(append, transaction);
+        }
+
+        return sync_data;
+    }
+
+    std::tuple<Error, std::vector<crypto_key_image_t>>
+        BlockchainStorage::collect_key_images(const std::vector<transaction_t> &transactions)
+    {
+        std::set<crypto_key_image_t> seen;
+
+        for (const auto &transaction : transactions)
+        {
+            const auto error = std::visit(
+                [&seen](auto &&arg)
+                {
+                    USEVARIANT(T, arg);
+
+                    if COMMITED_USER_TX_VARIANT (T)
+                    {
+                        for (const auto &key_image : arg.key_images)
+                        {
+                            // the same key image spent twice within the block
+                            if (!seen.insert(key_image).second)
+                            {
+                                return MAKE_ERROR(TX_DUPLICATE_KEY_IMAGE);
+                            }
+                        }
+                    }
+
+                    return MAKE_ERROR(SUCCESS);
+                },
+                transaction);
+
+            if (error)
+            {
+                return {error, {}};
+            }
+        }
+
+        return {MAKE_ERROR(SUCCESS), std::vector<crypto_key_image_t>(seen.begin(), seen.end())};
+    }
+
     Error BlockchainStorage::del_block(const uint64_t &block_index)
     {
         auto [block_error, block, transactions] = get_block(block_index);
@@ -57,6 +191,18 @@ namespace Core
     try_again:
         auto txn = m_blocks->transaction();
 
+        // delete the block reward transaction so that its position is free for the block that replaces it
+        {
+            auto error = std::visit([&](auto &&arg) { return del_transaction(txn, arg); }, block.reward_tx);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, txn, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+        }
+
         for (const auto &transaction : transactions)
         {
             auto error = del_transaction(txn, transaction);
@@ -83,6 +229,20 @@ namespace Core
             }
         }
 
+        // delete block sync data, blocks stored before the table existed do not have any
+        {
+            txn->set_database(m_sync_data);
+
+            auto error = txn->del(block.block_index);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, txn, try_again);
+
+            if (error && error != LMDB_NOTFOUND)
+            {
+                return error;
+            }
+        }
+
         // delete block index
         {
             txn->set_database(m_block_indexes);
@@ -187,9 +347,30 @@ namespace Core
                     }
                 }
 
-                db_tx->set_database(m_transactions);
+                const auto txn_hash = tx.hash();
+
+                // look up the position of the transaction so that both rows may be deleted
+                db_tx->set_database(m_transaction_hashes);
+
+                const auto [error, position] = db_tx->get(txn_hash);
+
+                if (error)
+                {
+                    return error;
+                }
+
+                db_tx->set_database(m_block_transactions);
+
+                auto del_error = db_tx->del(serializer_t(position.unread_data()));
+
+                if (del_error)
+                {
+                    return del_error;
+                }
+
+                db_tx->set_database(m_transaction_hashes);
 
-                return db_tx->del(tx.hash());
+                return db_tx->del(txn_hash);
             },
             transaction);
     }
@@ -198,7 +379,26 @@ namespace Core
         std::unique_ptr<Database::LMDBTransaction> &db_tx,
         const crypto_hash_t &output_hash)
     {
-        db_tx->set_database(m_transaction_outputs);
+        // look up the position of the output so that both rows may be deleted
+        db_tx->set_database(m_output_hashes);
+
+        const auto [error, position] = db_tx->get(output_hash);
+
+        if (error)
+        {
+            return error;
+        }
+
+        db_tx->set_database(m_block_outputs);
+
+        auto del_error = db_tx->del(serializer_t(position.unread_data()));
+
+        if (del_error)
+        {
+            return del_error;
+        }
+
+        db_tx->set_database(m_output_hashes);
 
         return db_tx->del(output_hash);
     }
@@ -216,18 +416,35 @@ namespace Core
 
         std::vector<transaction_t> transactions;
 
-        // loop through the transactions in the block and retrieve them
-        for (const auto &txn : block.transactions)
+        auto txn = m_block_transactions->transaction(true);
+
+        auto cursor = txn->cursor();
+
+        // the transactions of the block are stored in order after the block reward transaction (position 0)
+        auto [cursor_error, key, value] = cursor->get(position_key(block.block_index, 1), MDB_SET_RANGE);
+
+        while (!cursor_error && transactions.size() < block.transactions.size())
         {
-            // retrieve the transaction
-            const auto [txn_error, transaction, txn_block_hash] = get_transaction(txn);
+            if (key.uint64(false, true) != block.block_index)
+            {
+                break;
+            }
+
+            const auto [txn_error, transaction, txn_block_hash] = parse_transaction(value);
 
             if (txn_error)
             {
-                return {MAKE_ERROR(DB_TRANSACTION_NOT_FOUND), {}, {}};
+                break;
             }
 
             transactions.push_back(transaction);
+
+            std::tie(cursor_error, key, value) = cursor->get(MDB_NEXT);
+        }
+
+        if (transactions.size() != block.transactions.size())
+        {
+            return {MAKE_ERROR(DB_TRANSACTION_NOT_FOUND), {}, {}};
         }
 
         return {MAKE_ERROR(SUCCESS), block, transactions};
@@ -301,24 +518,34 @@ namespace Core
     {
         std::vector<transaction_output_t> results;
 
-        if (m_transaction_outputs->count() < count)
+        if (m_output_hashes->count() < count)
         {
             return {
                 MAKE_ERROR_MSG(DB_TRANSACTION_OUTPUT_NOT_FOUND, "Not enough transaction outputs to complete request."),
                 {}};
         }
 
-        auto txn = m_transaction_outputs->transaction(true);
+        auto txn = m_output_hashes->transaction(true);
 
         auto cursor = txn->cursor();
 
+        // the cursor walks the hash index while the outputs themselves are read by their position
+        txn->set_database(m_block_outputs);
+
         while (results.size() < count)
         {
             const auto random_hash = Crypto::random_hash();
 
-            auto [error, key, value] = cursor->get(random_hash, MDB_SET_RANGE);
+            auto [cursor_error, key, position] = cursor->get(random_hash, MDB_SET_RANGE);
+
+            if (cursor_error == LMDB_NOTFOUND)
+            {
+                continue;
+            }
+
+            auto [error, value] = txn->get(serializer_t(position.unread_data()));
 
-            if (error == LMDB_NOTFOUND)
+            if (error)
             {
                 continue;
             }
@@ -345,54 +572,143 @@ namespace Core
         return {MAKE_ERROR(SUCCESS), results};
     }
 
+    std::tuple<Error, block_sync_data_t> BlockchainStorage::get_sync_data(const uint64_t &block_index) const
+    {
+        {
+            const auto [error, sync_data] = m_sync_data->get<block_sync_data_t>(block_index);
+
+            if (!error)
+            {
+                return {error, sync_data};
+            }
+        }
+
+        // blocks stored before the sync data table existed have it built on demand
+        const auto [error, block, transactions] = get_block(block_index);
+
+        if (error)
+        {
+            return {error, {}};
+        }
+
+        return {MAKE_ERROR(SUCCESS), build_sync_data(block, transactions)};
+    }
+
+    std::tuple<Error, std::vector<uint8_t>, size_t>
+        BlockchainStorage::get_sync_data(const uint64_t &start_index, size_t count) const
+    {
+        const auto block_count = get_block_count();
+
+        if (start_index >= block_count)
+        {
+            return {MAKE_ERROR(DB_BLOCK_NOT_FOUND), {}, 0};
+        }
+
+        const auto end_index = start_index + std::min<uint64_t>(count, block_count - start_index);
+
+        serializer_t writer;
+
+        auto block_index = start_index;
+
+        // blocks stored before the sync data table existed have no row and have it built on demand
+        const auto build_until = [&](uint64_t next_index)
+        {
+            for (; block_index < next_index; ++block_index)
+            {
+                const auto [error, block, transactions] = get_block(block_index);
+
+                if (error)
+                {
+                    return error;
+                }
+
+                build_sync_data(block, transactions).serialize(writer);
+            }
+
+            return MAKE_ERROR(SUCCESS);
+        };
+
+        Database::lmdb_iterator_options_t options;
+
+        options.start_key = m_sync_data->encode_key(start_index).vector();
+
+        options.end_key = m_sync_data->encode_key(end_index).vector();
+
+        // the stored rows are read with a single cursor and their encoding is passed through as is
+        for (auto &entry : m_sync_data->iterate(options))
+        {
+            auto error = build_until(m_sync_data->decode_key(entry.key));
+
+            if (error)
+            {
+                return {error, {}, 0};
+            }
+
+            const auto bytes = entry.value.unread_data();
+
+            writer.bytes(bytes.data(), bytes.size());
+
+            block_index++;
+        }
+
+        auto error = build_until(end_index);
+
+        if (error)
+        {
+            return {error, {}, 0};
+        }
+
+        return {MAKE_ERROR(SUCCESS), writer.vector(), end_index - start_index};
+    }
+
     std::tuple<Error, transaction_t, crypto_hash_t>
         BlockchainStorage::get_transaction(const crypto_hash_t &txn_hash) const
     {
-        // go get the transaction
-        const auto [error, txn_data] = m_transactions->get(txn_hash);
+        auto txn = m_transaction_hashes->transaction(true);
+
+        // go get the position of the transaction
+        const auto [error, position] = txn->get(txn_hash);
 
         if (error)
         {
             return {MAKE_ERROR(DB_TRANSACTION_NOT_FOUND), {}, {}};
         }
 
-        deserializer_t reader(txn_data);
-
-        const auto block_hash = reader.key<crypto_hash_t>();
+        // go get the transaction
+        txn->set_database(m_block_transactions);
 
-        // figure out what type of transaction it is
-        const auto type = reader.varint<uint64_t>(true);
+        auto [txn_error, txn_data] = txn->get(serializer_t(position.unread_data()));
 
-        // depending on the transaction type, we'll return the proper structure
-        switch (type)
+        if (txn_error)
         {
-            case TransactionType::GENESIS:
-                return {MAKE_ERROR(SUCCESS), genesis_transaction_t(reader), block_hash};
-            case TransactionType::STAKER:
-                return {MAKE_ERROR(SUCCESS), staker_transaction_t(reader), block_hash};
-            case TransactionType::NORMAL:
-                return {MAKE_ERROR(SUCCESS), committed_normal_transaction_t(reader), block_hash};
-            case TransactionType::STAKE:
-                return {MAKE_ERROR(SUCCESS), committed_stake_transaction_t(reader), block_hash};
-            case TransactionType::RECALL_STAKE:
-                return {MAKE_ERROR(SUCCESS), committed_recall_stake_transaction_t(reader), block_hash};
-            case TransactionType::STAKE_REFUND:
-                return {MAKE_ERROR(SUCCESS), stake_refund_transaction_t(reader), block_hash};
-            default:
-                return {MAKE_ERROR(UNKNOWN_TRANSACTION_TYPE), {}, block_hash};
+            return {MAKE_ERROR(DB_TRANSACTION_NOT_FOUND), {}, {}};
         }
+
+        return parse_transaction(txn_data);
     }
 
     std::tuple<Error, transaction_output_t, uint64_t>
         BlockchainStorage::get_transaction_output(const crypto_hash_t &output_hash) const
     {
-        auto [error, output_data] = m_transaction_outputs->get(output_hash);
+        auto txn = m_output_hashes->transaction(true);
+
+        // go get the position of the output
+        const auto [error, position] = txn->get(output_hash);
 
         if (error)
         {
             return {MAKE_ERROR(DB_TRANSACTION_OUTPUT_NOT_FOUND), {}, {}};
         }
 
+        txn->set_database(m_block_outputs);
+
+        auto [output_error, output_data] = txn->get(serializer_t(position.unread_data()));
+
+        if (output_error)
+        {
+            return {MAKE_ERROR(DB_TRANSACTION_OUTPUT_NOT_FOUND), {}, {}};
+        }
+
         transaction_output_t output;
 
         output.deserialize(output_data);
@@ -445,144 +761,223 @@ namespace Core
 
     bool BlockchainStorage::key_image_exists(const std::vector<crypto_key_image_t> &key_images) const
     {
-        std::vector<crypto_key_image_t> results;
+        auto probes = key_images;
 
-        auto txn = m_key_images->transaction(true);
+        // sorted probes walk the B-tree in order and duplicates are only probed once
+        std::sort(probes.begin(), probes.end());
 
-        bool exists = false;
+        probes.erase(std::unique(probes.begin(), probes.end()), probes.end());
+
+        auto txn = m_key_images->transaction(true);
 
         // loop through the requested key images
-        for (const auto &key_image : key_images)
+        for (const auto &key_image : probes)
         {
             // check to see if the key image exists
             if (txn->exists(key_image))
             {
-                exists = true;
+                return true;
             }
         }
 
-        return exists;
+        return false;
     }
 
-    size_t BlockchainStorage::output_count() const
+    Error BlockchainStorage::migrate_block(
+        std::unique_ptr<Database::LMDBTransaction> &db_tx,
+        const std::shared_ptr<Database::LMDBDatabase> &legacy_transactions,
+        const std::shared_ptr<Database::LMDBDatabase> &legacy_outputs,
+        uint64_t block_index)
     {
-        return m_transaction_outputs->count();
-    }
+        db_tx->set_database(m_block_indexes);
 
-    bool BlockchainStorage::output_exists(const crypto_hash_t &output_hash) const
-    {
-        return m_transaction_outputs->exists(output_hash);
-    }
+        auto [index_error, index_reader] = db_tx->get(block_index);
 
-    Error BlockchainStorage::put_block(const block_t &block, const std::vector<transaction_t> &transactions)
-    {
-        /**
-         * Sanity check transaction order before write
-         */
+        if (index_error)
         {
-            // verify that the number of transactions match what is expected
-            if (transactions.size() != block.transactions.size())
-            {
-                return MAKE_ERROR(BLOCK_TXN_MISMATCH);
-            }
+            return MAKE_ERROR(DB_BLOCK_NOT_FOUND);
+        }
 
-            // dump the transaction hashes into two vectors so that we can easily compare them
-            std::vector<crypto_hash_t> block_tx_hashes, txn_hashes;
+        const auto block_hash = index_reader.key<crypto_hash_t>();
 
-            for (const auto &tx : block.transactions)
-            {
-                block_tx_hashes.push_back(tx);
-            }
+        db_tx->set_database(m_blocks);
 
-            for (const auto &tx : transactions)
-            {
-                std::visit([&txn_hashes](auto &&arg) { txn_hashes.push_back(arg.hash()); }, tx);
-            }
+        const auto [block_error, block] = db_tx->get<block_t>(block_hash);
 
-            // hash the vectors to get a result that we can match against
-            const auto block_hashes = Crypto::Hashing::sha3(block_tx_hashes);
+        if (block_error)
+        {
+            return MAKE_ERROR(DB_BLOCK_NOT_FOUND);
+        }
 
-            const auto tx_hashes = Crypto::Hashing::sha3(txn_hashes);
+        // the block reward transaction is at position 0 followed by the transactions of the block in order
+        std::vector<crypto_hash_t> txn_hashes {std::visit([](auto &&arg) { return arg.hash(); }, block.reward_tx)};
 
-            /**
-             * Compare the resulting hashes and if they do not match, then kick back out.
-             * The reason that we do this is that it guarantees that the order of the transactions
-             * are processed in is the same at each node so that the global indexes match across
-             * multiple nodes
-             */
-            if (block_hashes != tx_hashes)
+        txn_hashes.insert(txn_hashes.end(), block.transactions.begin(), block.transactions.end());
+
+        uint32_t output_position = 0;
+
+        for (uint32_t position = 0; position < txn_hashes.size(); ++position)
+        {
+            const auto &txn_hash = txn_hashes[position];
+
+            db_tx->set_database(legacy_transactions);
+
+            auto [txn_error, txn_data] = db_tx->get(txn_hash);
+
+            if (txn_error)
             {
-                return MAKE_ERROR(BLOCK_TXN_ORDER);
+                return MAKE_ERROR(DB_TRANSACTION_NOT_FOUND);
             }
-        }
 
-        std::scoped_lock lock(write_mutex);
+            // the stored encoding of the transaction is moved as is
+            {
+                const auto key = position_key(block_index, position);
 
-        const auto block_hash = block.hash();
+                db_tx->set_database(m_block_transactions);
 
-    try_again:
+                auto error = db_tx->append(key, serializer_t(txn_data.unread_data()));
 
-        auto db_tx = m_db_env->transaction();
+                if (error)
+                {
+                    return error;
+                }
 
-        // Push the block reward transaction into the database
-        {
-            auto [error, txn_hash] =
-                std::visit([&](auto &&arg) { return put_transaction(db_tx, arg, block_hash); }, block.reward_tx);
+                db_tx->set_database(m_transaction_hashes);
 
-            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+                error = db_tx->put(txn_hash, key);
 
-            if (error)
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            const auto [parse_error, transaction, txn_block_hash] = parse_transaction(txn_data);
+
+            if (parse_error)
             {
-                return error;
+                return parse_error;
             }
-        }
 
-        // loop through the individual transactions in the block and push them into the database
-        for (const auto &transaction : transactions)
-        {
-            auto [error, txn_hash] = put_transaction(db_tx, transaction, block_hash);
+            // the outputs of the transaction follow the outputs of the transactions before it
+            const auto output_hashes = std::visit(
+                [](auto &&arg)
+                {
+                    USEVARIANT(T, arg);
 
-            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+                    std::vector<crypto_hash_t> hashes;
 
-            if (error)
+                    if COMMITED_USER_TX_VARIANT (T)
+                    {
+                        for (const auto &output : arg.outputs)
+                        {
+                            hashes.push_back(output.hash());
+                        }
+                    }
+                    else if VARIANT (T, genesis_transaction_t)
+                    {
+                        for (const auto &output : arg.outputs)
+                        {
+                            hashes.push_back(output.hash());
+                        }
+                    }
+                    else if VARIANT (T, stake_refund_transaction_t)
+                    {
+                        for (const auto &output : arg.outputs)
+                        {
+                            hashes.push_back(output.hash());
+                        }
+                    }
+
+                    return hashes;
+                },
+                transaction);
+
+            for (const auto &output_hash : output_hashes)
             {
-                return error;
+                db_tx->set_database(legacy_outputs);
+
+                auto [output_error, output_data] = db_tx->get(output_hash);
+
+                if (output_error)
+                {
+                    return MAKE_ERROR(DB_TRANSACTION_OUTPUT_NOT_FOUND);
+                }
+
+                const auto key = position_key(block_index, output_position++);
+
+                db_tx->set_database(m_block_outputs);
+
+                auto error = db_tx->append(key, serializer_t(output_data.unread_data()));
+
+                if (error)
+                {
+                    return error;
+                }
+
+                db_tx->set_database(m_output_hashes);
+
+                error = db_tx->put(output_hash, key);
+
+                if (error)
+                {
+                    return error;
+                }
             }
         }
 
-        // push the block itself into the database
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    Error BlockchainStorage::migrate_transactions()
+    {
+        if (!m_db_env->database_exists("transactions"))
         {
-            db_tx->set_database(m_blocks);
+            return MAKE_ERROR(SUCCESS);
+        }
 
-            auto error = db_tx->put(block_hash, block);
+        const auto legacy_transactions = m_db_env->open_database("transactions");
 
-            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+        const auto legacy_outputs = m_db_env->open_database("transaction_outputs");
 
-            if (error)
-            {
-                return error;
-            }
-        }
+        const auto block_count = get_block_count();
+
+        uint64_t block_index = 0;
 
-        // push the block index into the database for easy retrieval later
+        // every block has a block reward transaction, so the last one stored is the last block migrated
         {
-            db_tx->set_database(m_block_indexes);
+            auto txn = m_block_transactions->transaction(true);
 
-            auto error = db_tx->put(block.block_index, block_hash);
+            auto cursor = txn->cursor();
 
-            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+            auto [error, key, value] = cursor->get(MDB_LAST);
 
-            if (error)
+            if (!error)
             {
-                return error;
+                block_index = key.uint64(false, true) + 1;
             }
         }
 
-        // push the block timestamp into the database for easy retrieval later
+        while (block_index < block_count)
         {
-            db_tx->set_database(m_block_timestamps);
+            const auto batch_end = std::min<uint64_t>(block_index + MIGRATION_BATCH_BLOCKS, block_count);
+
+        try_again:
+            auto db_tx = m_db_env->transaction();
+
+            for (auto i = block_index; i < batch_end; ++i)
+            {
+                auto error = migrate_block(db_tx, legacy_transactions, legacy_outputs, i);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
 
-            auto error = db_tx->put(block.timestamp, block_hash);
+            auto error = db_tx->commit();
 
             MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
 
@@ -590,172 +985,329 @@ namespace Core
             {
                 return error;
             }
+
+            block_index = batch_end;
         }
 
-        auto error = db_tx->commit();
+        auto error = legacy_transactions->drop(true);
 
-        MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+        if (error)
+        {
+            return error;
+        }
 
-        return error;
+        return legacy_outputs->drop(true);
     }
 
-    Error BlockchainStorage::put_key_image(
-        std::unique_ptr<Database::LMDBTransaction> &db_tx,
-        const crypto_key_image_t &key_image)
+    size_t BlockchainStorage::output_count() const
     {
-        db_tx->set_database(m_key_images);
+        return m_output_hashes->count();
+    }
 
-        return db_tx->put(key_image);
+    bool BlockchainStorage::output_exists(const crypto_hash_t &output_hash) const
+    {
+        return m_output_hashes->exists(output_hash);
     }
 
-    std::tuple<Error, crypto_hash_t> BlockchainStorage::put_transaction(
-        std::unique_ptr<Database::LMDBTransaction> &db_tx,
-        const transaction_t &transaction,
-        const crypto_hash_t &block_hash)
+    std::tuple<Error, transaction_t, crypto_hash_t> BlockchainStorage::parse_transaction(deserializer_t &reader)
     {
-        db_tx->set_database(m_transactions);
+        const auto block_hash = reader.key<crypto_hash_t>();
 
-        crypto_hash_t txn_hash;
+        // figure out what type of transaction it is
+        const auto type = reader.varint<uint64_t>(true);
+
+        // depending on the transaction type, we'll return the proper structure
+        switch (type)
+        {
+            case TransactionType::GENESIS:
+                return {MAKE_ERROR(SUCCESS), genesis_transaction_t(reader), block_hash};
+            case TransactionType::STAKER:
+                return {MAKE_ERROR(SUCCESS), staker_transaction_t(reader), block_hash};
+            case TransactionType::NORMAL:
+                return {MAKE_ERROR(SUCCESS), committed_normal_transaction_t(reader), block_hash};
+            case TransactionType::STAKE:
+                return {MAKE_ERROR(SUCCESS), committed_stake_transaction_t(reader), block_hash};
+            case TransactionType::RECALL_STAKE:
+                return {MAKE_ERROR(SUCCESS), committed_recall_stake_transaction_t(reader), block_hash};
+            case TransactionType::STAKE_REFUND:
+                return {MAKE_ERROR(SUCCESS), stake_refund_transaction_t(reader), block_hash};
+            default:
+                return {MAKE_ERROR(UNKNOWN_TRANSACTION_TYPE), {}, block_hash};
+        }
+    }
+
+    std::tuple<Error, BlockchainStorage::block_rows_t>
+        BlockchainStorage::prepare_block(const block_t &block, const std::vector<transaction_t> &transactions)
+    {
+        // key image conflicts within the block are caught before we touch the database
+        const auto [key_image_error, key_images] = collect_key_images(transactions);
+
+        if (key_image_error)
+        {
+            return {key_image_error, {}};
+        }
+
+        std::vector<crypto_hash_t> txn_hashes;
 
         /**
-         * The reason that this looks so convoluted is because of the use
-         * of std::variant for the different types of transactions
+         * Sanity check transaction order before write
          */
         {
-            auto error = std::visit(
-                [&](auto &&arg)
-                {
-                    USEVARIANT(T, arg);
+            // verify that the number of transactions match what is expected
+            if (transactions.size() != block.transactions.size())
+            {
+                return {MAKE_ERROR(BLOCK_TXN_MISMATCH), {}};
+            }
 
-                    {
-                        txn_hash = arg.hash();
+            // dump the transaction hashes into two vectors so that we can easily compare them
+            std::vector<crypto_hash_t> block_tx_hashes;
 
-                        serializer_t writer;
+            for (const auto &tx : block.transactions)
+            {
+                block_tx_hashes.push_back(tx);
+            }
 
-                        arg.serialize(writer);
+            for (const auto &tx : transactions)
+            {
+                std::visit([&txn_hashes](auto &&arg) { txn_hashes.push_back(arg.hash()); }, tx);
+            }
 
-                        writer.key(block_hash);
+            // hash the vectors to get a result that we can match against
+            const auto block_hashes = Crypto::Hashing::sha3(block_tx_hashes);
 
-                        // push the transaction itself into the database
-                        auto error = db_tx->put(txn_hash, writer);
+            const auto tx_hashes = Crypto::Hashing::sha3(txn_hashes);
 
-                        if (error)
-                        {
-                            return error;
-                        }
-                    }
+            /**
+             * Compare the resulting hashes and if they do not match, then kick back out.
+             * The reason that we do this is that it guarantees that the order of the transactions
+             * are processed in is the same at each node so that the global indexes match across
+             * multiple nodes
+             */
+            if (block_hashes != tx_hashes)
+            {
+                return {MAKE_ERROR(BLOCK_TXN_ORDER), {}};
+            }
+        }
 
-                    // handle the key images on each type of transaction
-                    if COMMITED_USER_TX_VARIANT (T)
-                    {
-                        // loop through the key images in the transaction and push them into the database
-                        for (const auto &key_image : arg.key_images)
-                        {
-                            auto error = put_key_image(db_tx, key_image);
+        const auto block_hash = block.hash();
 
-                            if (error)
-                            {
-                                return error;
-                            }
-                        }
-                    }
+        block_rows_t rows;
 
-                    return MAKE_ERROR(SUCCESS);
-                },
-                transaction);
+        rows.block_hash = block_hash;
 
-            if (error)
+        rows.block_index = block.block_index;
+
+        rows.timestamp = block.timestamp;
+
+        rows.key_images = key_images;
+
+        block.serialize(rows.block);
+
+        // the wallet sync data is built once here rather than each time that it is requested
+        build_sync_data(block, transactions).serialize(rows.sync_data);
+
+        // only the outputs (and their unlock block) of these types of transactions are stored for the global indexes
+        const auto stored_outputs = [](auto &&arg) -> std::tuple<const std::vector<transaction_output_t> *, uint64_t>
+        {
+            USEVARIANT(T, arg);
+
+            if COMMITED_USER_TX_VARIANT (T)
             {
-                return {error, txn_hash};
+                return {&arg.outputs, arg.unlock_block};
             }
-        }
+            else if VARIANT (T, genesis_transaction_t)
+            {
+                return {&arg.outputs, arg.unlock_block};
+            }
+            else if VARIANT (T, stake_refund_transaction_t)
+            {
+                return {&arg.outputs, arg.unlock_block};
+            }
+
+            return {nullptr, 0};
+        };
 
         /**
-         * The reason that this looks so convoluted is because of the use
-         * of std::variant for the different types of transactions
+         * Each transaction writes its rows into the slots reserved for its position (and the positions
+         * of its outputs) so that the transactions may be prepared by multiple threads without locking
          */
+        const auto prepare = [&](auto &&arg, const crypto_hash_t &txn_hash, uint32_t position, uint32_t output_position)
         {
-            auto error = std::visit(
-                [&](auto &&arg)
-                {
-                    USEVARIANT(T, arg);
+            const auto key = position_key(block.block_index, position);
 
-                    // handle the different types of transactions
-                    if COMMITED_USER_TX_VARIANT (T)
-                    {
-                        const auto txn_hash = arg.hash();
+            serializer_t writer;
 
-                        // loop through the outputs and push them into the database for the global indexes
-                        for (const auto &output : arg.outputs)
-                        {
-                            auto error = put_transaction_output(db_tx, output, arg.unlock_block);
+            arg.serialize(writer);
 
-                            if (error)
-                            {
-                                return error;
-                            }
-                        }
-                    }
-                    else if VARIANT (T, genesis_transaction_t)
-                    {
-                        const auto txn_hash = arg.hash();
+            writer.key(block_hash);
 
-                        // loop through the outputs and push them into the database for the global indexes
-                        for (const auto &output : arg.outputs)
-                        {
-                            auto error = put_transaction_output(db_tx, output, arg.unlock_block);
+            rows.transactions[position] = {key, writer};
 
-                            if (error)
-                            {
-                                return error;
-                            }
-                        }
-                    }
-                    else if VARIANT (T, stake_refund_transaction_t)
-                    {
-                        const auto txn_hash = arg.hash();
+            rows.transaction_hashes[position] = {txn_hash, key};
 
-                        // loop through the outputs and put them in the database
-                        for (const auto &output : arg.outputs)
-                        {
-                            // push the output into the database
-                            auto error = put_transaction_output(db_tx, output, arg.unlock_block);
+            const auto [outputs, unlock_block] = stored_outputs(arg);
 
-                            if (error)
-                            {
-                                return error;
-                            }
-                        }
-                    }
+            if (outputs == nullptr)
+            {
+                return;
+            }
 
-                    return MAKE_ERROR(SUCCESS);
-                },
-                transaction);
+            for (const auto &output : *outputs)
+            {
+                const auto output_key = position_key(block.block_index, output_position);
 
-            if (error)
+                // we pack the unlock block on to the output for storage
+                serializer_t output_writer;
+
+                output_writer.varint(unlock_block);
+
+                output.serialize(output_writer);
+
+                rows.outputs[output_position] = {output_key, output_writer};
+
+                rows.output_hashes[output_position] = {output.hash(), output_key};
+
+                output_position++;
+            }
+        };
+
+        const auto output_count = [&](auto &&arg)
+        {
+            const auto [outputs, unlock_block] = stored_outputs(arg);
+
+            return static_cast<uint32_t>((outputs == nullptr) ? 0 : outputs->size());
+        };
+
+        // the block reward transaction is at position 0 followed by the transactions of the block in order,
+        // each entry is the first output position of the transaction at that position and the last entry
+        // is the total number of outputs in the block
+        std::vector<uint32_t> output_positions(transactions.size() + 2, 0);
+
+        output_positions[1] = std::visit(output_count, block.reward_tx);
+
+        for (size_t i = 0; i < transactions.size(); ++i)
+        {
+            output_positions[i + 2] = output_positions[i + 1] + std::visit(output_count, transactions[i]);
+        }
+
+        const auto total_outputs = output_positions.back();
+
+        rows.transactions.resize(transactions.size() + 1);
+
+        rows.transaction_hashes.resize(transactions.size() + 1);
+
+        rows.outputs.resize(total_outputs);
+
+        rows.output_hashes.resize(total_outputs);
+
+        std::visit([&](auto &&arg) { prepare(arg, arg.hash(), 0, 0); }, block.reward_tx);
+
+        std::atomic<size_t> next = 0;
+
+        const auto runner = [&]()
+        {
+            for (auto i = next++; i < transactions.size(); i = next++)
             {
-                return {error, txn_hash};
+                const auto position = static_cast<uint32_t>(i + 1);
+
+                std::visit(
+                    [&](auto &&arg) { prepare(arg, txn_hashes[i], position, output_positions[position]); },
+                    transactions[i]);
             }
+        };
+
+        std::vector<std::thread> threads;
+
+        // the calling thread prepares transactions too so that small blocks do not start any threads
+        const auto count = std::min<size_t>(
+            transactions.size() / PREPARE_TRANSACTIONS_PER_THREAD, std::thread::hardware_concurrency());
+
+        for (size_t i = 1; i < count; ++i)
+        {
+            threads.emplace_back(runner);
+        }
+
+        runner();
+
+        for (auto &thread : threads)
+        {
+            thread.join();
         }
 
-        return {MAKE_ERROR(SUCCESS), txn_hash};
+        // the hash indexes are written in key order so that the writes walk each B-tree once
+        std::sort(
+            rows.transaction_hashes.begin(),
+            rows.transaction_hashes.end(),
+            [](const auto &a, const auto &b) { return std::get<0>(a) < std::get<0>(b); });
+
+        std::sort(
+            rows.output_hashes.begin(),
+            rows.output_hashes.end(),
+            [](const auto &a, const auto &b) { return std::get<0>(a) < std::get<0>(b); });
+
+        return {MAKE_ERROR(SUCCESS), rows};
     }
 
-    Error BlockchainStorage::put_transaction_output(
-        std::unique_ptr<Database::LMDBTransaction> &db_tx,
-        const transaction_output_t &output,
-        uint64_t unlock_block)
+    Error BlockchainStorage::put_block(const block_t &block, const std::vector<transaction_t> &transactions)
     {
-        db_tx->set_database(m_transaction_outputs);
+        put_block_timings_t timings;
 
-        // we pack the unlock block on to the output for storage
-        serializer_t writer;
+        return put_block(block, transactions, timings);
+    }
+
+    Error BlockchainStorage::put_block(
+        const block_t &block,
+        const std::vector<transaction_t> &transactions,
+        put_block_timings_t &timings)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<block_rows_t> rows(1);
+
+        Error error;
+
+        std::tie(error, rows[0]) = prepare_block(block, transactions);
+
+        if (error)
+        {
+            return error;
+        }
+
+        return write_blocks(rows, start, timings);
+    }
+
+    Error BlockchainStorage::put_blocks(const std::vector<std::tuple<block_t, std::vector<transaction_t>>> &blocks)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<block_rows_t> rows(blocks.size());
+
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            const auto &[block, transactions] = blocks[i];
+
+            Error error;
+
+            std::tie(error, rows[i]) = prepare_block(block, transactions);
+
+            if (error)
+            {
+                return error;
+            }
+        }
 
-        writer.varint(unlock_block);
+        put_block_timings_t timings;
 
-        output.serialize(writer);
+        return write_blocks(rows, start, timings);
+    }
 
-        return db_tx->put(output.hash(), writer);
+    Error BlockchainStorage::put_key_image(
+        std::unique_ptr<Database::LMDBTransaction> &db_tx,
+        const crypto_key_image_t &key_image)
+    {
+        db_tx->set_database(m_key_images);
+
+        return db_tx->put(key_image);
     }
 
     Error BlockchainStorage::rewind(const uint64_t &block_index)
@@ -765,9 +1317,8 @@ namespace Core
             return MAKE_ERROR(DB_BLOCK_NOT_FOUND);
         }
 
-        const auto block_count = get_block_count();
-
-        for (uint64_t i = block_count; i > block_index; --i)
+        // the blocks are removed from the top down so that the tables are only ever trimmed at the tail
+        for (auto i = get_block_count() - 1; i > block_index; --i)
         {
             auto error = del_block(i);
 
@@ -782,6 +1333,187 @@ namespace Core
 
     bool BlockchainStorage::transaction_exists(const crypto_hash_t &txn_hash) const
     {
-        return m_transactions->exists(txn_hash);
+        return m_transaction_hashes->exists(txn_hash);
+    }
+
+    Error BlockchainStorage::write_blocks(
+        const std::vector<block_rows_t> &rows,
+        const std::chrono::steady_clock::time_point &start,
+        put_block_timings_t &timings)
+    {
+        std::scoped_lock lock(write_mutex);
+
+        auto attempt_start = std::chrono::steady_clock::now();
+
+        timings.preparation = attempt_start - start;
+
+        timings.expansion = std::chrono::nanoseconds(0);
+
+        timings.expansions = 0;
+
+        bool retrying = false;
+
+    try_again:
+
+        // if we are here again, the previous attempt was abandoned and the map expanded
+        if (retrying)
+        {
+            const auto now = std::chrono::steady_clock::now();
+
+            timings.expansion += now - attempt_start;
+
+            timings.expansions++;
+
+            attempt_start = now;
+        }
+
+        retrying = true;
+
+        auto db_tx = m_db_env->transaction();
+
+        // the blocks are written in order so that the keys of every table are still appended at the tail
+        for (const auto &block_rows : rows)
+        {
+            // push the transactions into the database in the order of their position in the block
+            db_tx->set_database(m_block_transactions);
+
+            for (const auto &[key, value] : block_rows.transactions)
+            {
+                auto error = db_tx->append(key, value);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // index the position of the transactions by their hash
+            db_tx->set_database(m_transaction_hashes);
+
+            for (const auto &[txn_hash, key] : block_rows.transaction_hashes)
+            {
+                auto error = db_tx->put(txn_hash, key);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // push the outputs into the database for the global indexes
+            db_tx->set_database(m_block_outputs);
+
+            for (const auto &[key, value] : block_rows.outputs)
+            {
+                auto error = db_tx->append(key, value);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // index the position of the outputs by their hash
+            db_tx->set_database(m_output_hashes);
+
+            for (const auto &[output_hash, key] : block_rows.output_hashes)
+            {
+                auto error = db_tx->put(output_hash, key);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // loop through the key images spent in the block and push them into the database
+            for (const auto &key_image : block_rows.key_images)
+            {
+                auto error = put_key_image(db_tx, key_image);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // push the block itself into the database
+            {
+                db_tx->set_database(m_blocks);
+
+                auto error = db_tx->put(block_rows.block_hash, block_rows.block);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // push the block index into the database for easy retrieval later
+            {
+                db_tx->set_database(m_block_indexes);
+
+                auto error = db_tx->append(block_rows.block_index, block_rows.block_hash);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // push the block timestamp into the database for easy retrieval later
+            {
+                db_tx->set_database(m_block_timestamps);
+
+                auto error = db_tx->append(block_rows.timestamp, block_rows.block_hash);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+
+            // push the block wallet sync data into the database
+            {
+                db_tx->set_database(m_sync_data);
+
+                auto error = db_tx->append(block_rows.block_index, block_rows.sync_data);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+        }
+
+        const auto commit_start = std::chrono::steady_clock::now();
+
+        timings.writes = commit_start - attempt_start;
+
+        auto error = db_tx->commit();
+
+        timings.commit = std::chrono::steady_clock::now() - commit_start;
+
+        MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+        return error;
     }
 } // namespace Core
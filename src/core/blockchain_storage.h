@@ -5,6 +5,7 @@
 #ifndef CORE_BLOCKCHAIN_STORAGE_H
 #define CORE_BLOCKCHAIN_STORAGE_H
 
+#include <chrono>
 #include <db_lmdb.h>
 #include <types.h>
 
@@ -12,6 +13,25 @@ using namespace Types::Blockchain;
 
 namespace Core
 {
+    /**
+     * The time spent in each phase of BlockchainStorage::put_block
+     */
+    struct put_block_timings_t
+    {
+        // the ordering checks, hashing, serializing the rows, building the wallet sync data, and the wait for the lock
+        std::chrono::nanoseconds preparation {0};
+
+        // the database writes of the attempt that was committed
+        std::chrono::nanoseconds writes {0};
+
+        std::chrono::nanoseconds commit {0};
+
+        // the attempts that were abandoned because the map was full, including the expansions themselves
+        std::chrono::nanoseconds expansion {0};
+
+        size_t expansions = 0;
+    };
+
     class BlockchainStorage
     {
       protected:
@@ -41,6 +61,18 @@ namespace Core
          */
         [[nodiscard]] bool block_exists(const uint64_t &block_index) const;
 
+        /**
+         * Collects the key images spent by the transactions without accessing the database
+         *
+         * Fails as soon as a key image is found to be spent more than once. The key images
+         * are returned in ascending order so that they may be probed as a single batch.
+         *
+         * @param transactions
+         * @return [error, key images]
+         */
+        [[nodiscard]] static std::tuple<Error, std::vector<crypto_key_image_t>>
+            collect_key_images(const std::vector<transaction_t> &transactions);
+
         /**
          * Retrieves the block and transactions within that block using the specified block hash
          *
@@ -108,6 +140,29 @@ namespace Core
         [[nodiscard]] std::tuple<Error, std::vector<transaction_output_t>>
             get_random_outputs(uint64_t block_index = 0, size_t count = 1) const;
 
+        /**
+         * Retrieves the wallet sync data of the block at the specified block index
+         *
+         * @param block_index
+         * @return
+         */
+        [[nodiscard]] std::tuple<Error, block_sync_data_t> get_sync_data(const uint64_t &block_index) const;
+
+        /**
+         * Retrieves the wallet sync data of up to the specified number of blocks beginning
+         * at the specified block index in its binary encoding (each block's sync data
+         * serialized back to back) so that it may be handed to a client without being
+         * decoded and encoded again
+         *
+         * The range stops early at the top of the chain
+         *
+         * @param start_index
+         * @param count
+         * @return [error, encoded sync data, number of blocks]
+         */
+        [[nodiscard]] std::tuple<Error, std::vector<uint8_t>, size_t>
+            get_sync_data(const uint64_t &start_index, size_t count) const;
+
         /**
          * Retrieves the transaction with the specified hash
          *
@@ -157,7 +212,8 @@ namespace Core
         /**
          * Checks if any of the specified key images exist in the database
          *
-         * If they do exist, the already existing key images are returned
+         * The key images are deduplicated and probed in ascending order using a single
+         * read transaction that stops at the first key image found
          *
          * @param key_images
          * @return
@@ -188,6 +244,29 @@ namespace Core
          */
         Error put_block(const block_t &block, const std::vector<transaction_t> &transactions);
 
+        /**
+         * Saves the block with the transactions specified in the database and records the
+         * time spent in each phase of the write
+         *
+         * @param block
+         * @param transactions
+         * @param timings
+         * @return
+         */
+        Error put_block(
+            const block_t &block,
+            const std::vector<transaction_t> &transactions,
+            put_block_timings_t &timings);
+
+        /**
+         * Saves the blocks with their transactions in the database in a single database
+         * transaction so that either all of the blocks are saved or none of them are
+         *
+         * @param blocks [block, transactions] in block order
+         * @return
+         */
+        Error put_blocks(const std::vector<std::tuple<block_t, std::vector<transaction_t>>> &blocks);
+
         /**
          * Rewinds the database to the given block index
          *
@@ -205,6 +284,36 @@ namespace Core
         [[nodiscard]] bool transaction_exists(const crypto_hash_t &txn_hash) const;
 
       private:
+        /**
+         * The rows that a block adds to the tables, serialized before the write lock is taken
+         */
+        struct block_rows_t
+        {
+            crypto_hash_t block_hash;
+
+            uint64_t block_index = 0, timestamp = 0;
+
+            serializer_t block, sync_data;
+
+            // in ascending order
+            std::vector<crypto_key_image_t> key_images;
+
+            // keyed by (block index, position) in position order
+            std::vector<std::tuple<serializer_t, serializer_t>> transactions, outputs;
+
+            // the position keys by hash in hash order
+            std::vector<std::tuple<crypto_hash_t, serializer_t>> transaction_hashes, output_hashes;
+        };
+
+        /**
+         * Builds the wallet sync data of the block from the block and its transactions
+         *
+         * @param block
+         * @param transactions
+         * @return
+         */
+        static block_sync_data_t build_sync_data(const block_t &block, const std::vector<transaction_t> &transactions);
+
         /**
          * Delete a block and it's transactions from the database
          *
@@ -241,44 +350,82 @@ namespace Core
             del_transaction_output(std::unique_ptr<Database::LMDBTransaction> &db_tx, const crypto_hash_t &output_hash);
 
         /**
-         * Saves the specified key image to the database
+         * Moves the transactions and outputs of the block at the specified block index from
+         * the legacy tables keyed by hash into the tables keyed by (block index, position)
          *
          * @param db_tx
-         * @param key_image
+         * @param legacy_transactions
+         * @param legacy_outputs
+         * @param block_index
          * @return
          */
-        Error put_key_image(std::unique_ptr<Database::LMDBTransaction> &db_tx, const crypto_key_image_t &key_image);
+        Error migrate_block(
+            std::unique_ptr<Database::LMDBTransaction> &db_tx,
+            const std::shared_ptr<Database::LMDBDatabase> &legacy_transactions,
+            const std::shared_ptr<Database::LMDBDatabase> &legacy_outputs,
+            uint64_t block_index);
 
         /**
-         * Saves the specified transaction to the database
+         * Migrates databases that store transactions and outputs keyed by their hash to the
+         * layout keyed by (block index, position). The blocks are migrated in batches so that
+         * an interrupted migration resumes after the last batch that was committed, the legacy
+         * tables are dropped once every block has been migrated.
          *
-         * @param db_tx
-         * @param transaction
-         * @param block_hash
          * @return
          */
-        std::tuple<Error, crypto_hash_t> put_transaction(
-            std::unique_ptr<Database::LMDBTransaction> &db_tx,
-            const transaction_t &transaction,
-            const crypto_hash_t &block_hash);
+        Error migrate_transactions();
 
         /**
-         * Saves the specified transaction output to the database
+         * Parses a transaction as it is stored in the database
+         *
+         * @param reader
+         * @return [error, transaction, block hash]
+         */
+        static std::tuple<Error, transaction_t, crypto_hash_t> parse_transaction(deserializer_t &reader);
+
+        /**
+         * Checks that the transactions match the block and serializes the block, its transactions,
+         * their outputs, and the wallet sync data into the rows that are written to the database,
+         * the transactions of large blocks are prepared by multiple threads
+         *
+         * @param block
+         * @param transactions
+         * @return [error, rows]
+         */
+        static std::tuple<Error, block_rows_t>
+            prepare_block(const block_t &block, const std::vector<transaction_t> &transactions);
+
+        /**
+         * Saves the specified key image to the database
          *
          * @param db_tx
-         * @param output
-         * @param unlock_block
+         * @param key_image
          * @return
          */
-        Error put_transaction_output(
-            std::unique_ptr<Database::LMDBTransaction> &db_tx,
-            const transaction_output_t &output,
-            uint64_t unlock_block);
+        Error put_key_image(std::unique_ptr<Database::LMDBTransaction> &db_tx, const crypto_key_image_t &key_image);
+
+        /**
+         * Writes the rows of the blocks in a single database transaction, the time spent waiting
+         * for the write lock is counted from the start of the preparation
+         *
+         * @param rows
+         * @param start
+         * @param timings
+         * @return
+         */
+        Error write_blocks(
+            const std::vector<block_rows_t> &rows,
+            const std::chrono::steady_clock::time_point &start,
+            put_block_timings_t &timings);
 
         std::shared_ptr<Database::LMDB> m_db_env;
 
-        std::shared_ptr<Database::LMDBDatabase> m_blocks, m_block_indexes, m_block_timestamps, m_transactions,
-            m_key_images, m_transaction_outputs;
+        /**
+         * The transactions and outputs are keyed by (block index, position) so that the rows of
+         * a block are adjacent and appended at the tail, the hash tables map to those keys
+         */
+        std::shared_ptr<Database::LMDBDatabase> m_blocks, m_block_indexes, m_block_timestamps, m_block_transactions,
+            m_transaction_hashes, m_key_images, m_block_outputs, m_output_hashes, m_sync_data;
 
         crypto_hash_t m_id;
 
@@ -0,0 +1,304 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "chain_generator.h"
+
+#include <network_fees.h>
+
+// the number of points in each of the two pools, key images are drawn from POINT_POOL_SIZE^2 combinations
+#define POINT_POOL_SIZE 8'192
+#define BLOCK_TARGET_TIME 30
+#define MAXIMUM_OUTPUT_AMOUNT 1'000'000'000
+#define STAKE_AMOUNT_UNIT 1'000'000
+
+namespace Core
+{
+    ChainGenerator::ChainGenerator(const chain_generator_config_t &config):
+        m_config(config),
+        m_random(config.seed),
+        m_transaction_types({double(config.normal_weight),
+                             double(config.stake_weight),
+                             double(config.recall_stake_weight)}),
+        // the input and output counts of normal transactions skew heavily towards the small end
+        m_inputs({0, 40, 30, 12, 8, 4, 3, 2, 1}),
+        m_outputs({0, 0, 70, 12, 8, 4, 3, 2, 1})
+    {
+        m_pool_a.reserve(POINT_POOL_SIZE);
+
+        m_pool_b.reserve(POINT_POOL_SIZE);
+
+        for (size_t i = 0; i < POINT_POOL_SIZE; ++i)
+        {
+            m_pool_a.push_back(Crypto::secret_key_to_public_key(crypto_scalar_t(m_random())));
+
+            m_pool_b.push_back(Crypto::secret_key_to_public_key(crypto_scalar_t(m_random())));
+        }
+
+        for (size_t i = 0; i < std::max<size_t>(m_config.candidates, 1); ++i)
+        {
+            m_candidates.push_back(pool_point());
+        }
+
+        m_config.transactions_per_block =
+            std::min(m_config.transactions_per_block, Configuration::Consensus::MAXIMUM_BLOCK_TRANSACTIONS);
+    }
+
+    uint64_t ChainGenerator::block_index() const
+    {
+        return m_block_index;
+    }
+
+    template<typename T> void ChainGenerator::fill(T &tx, size_t inputs, size_t outputs)
+    {
+        tx.public_key = unique_point();
+
+        for (size_t i = 0; i < inputs; ++i)
+        {
+            tx.key_images.push_back(unique_point());
+        }
+
+        for (size_t i = 0; i < outputs; ++i)
+        {
+            tx.outputs.emplace_back(pool_point(), 1 + m_random() % MAXIMUM_OUTPUT_AMOUNT, pool_point());
+        }
+
+        tx.signature_hash = random_hash();
+
+        tx.range_proof_hash = random_hash();
+
+        // leave room for the nonce to grow while mining
+        tx.fee = Common::NetworkFees::calculate_transaction_fee(
+            tx.size() + 16, Configuration::Transaction::Fees::MINIMUM_POW_ZEROS);
+
+        while (m_config.mine && !tx.pow_verify(Configuration::Transaction::Fees::MINIMUM_POW_ZEROS))
+        {
+            tx.nonce++;
+        }
+
+        m_transactions++;
+
+        m_outputs_generated += outputs;
+
+        m_key_images += inputs;
+    }
+
+    Error ChainGenerator::generate(
+        std::shared_ptr<BlockchainStorage> &storage,
+        uint64_t count,
+        const progress_callback_t &callback,
+        uint64_t callback_interval)
+    {
+        if (m_block_index == 0 && storage->get_block_count() != 0)
+        {
+            return MAKE_ERROR(DB_NOT_EMPTY);
+        }
+
+        callback_interval = std::max<uint64_t>(callback_interval, 1);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            const auto [block, transactions] = next_block();
+
+            auto error = storage->put_block(block, transactions);
+
+            if (error)
+            {
+                return error;
+            }
+
+            if (callback && ((i + 1) % callback_interval == 0 || i + 1 == count))
+            {
+                callback(i + 1);
+            }
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    size_t ChainGenerator::key_image_count() const
+    {
+        return m_key_images;
+    }
+
+    std::tuple<block_t, std::vector<transaction_t>> ChainGenerator::next_block()
+    {
+        block_t block;
+
+        block.block_index = m_block_index;
+
+        block.previous_blockhash = m_previous_blockhash;
+
+        block.timestamp = m_config.first_timestamp + m_block_index * BLOCK_TARGET_TIME;
+
+        staker_transaction_t reward;
+
+        // the producer of the block and a handful of the validators that signed it
+        const auto stakers = 1 + m_random() % 4;
+
+        for (size_t i = 0; i < stakers; ++i)
+        {
+            reward.staker_outputs.emplace_back(random_hash(), 1 + m_random() % STAKE_AMOUNT_UNIT);
+        }
+
+        block.reward_tx = reward;
+
+        std::vector<std::tuple<crypto_hash_t, transaction_t>> generated;
+
+        generated.reserve(m_config.transactions_per_block);
+
+        for (size_t i = 0; i < m_config.transactions_per_block; ++i)
+        {
+            switch (m_transaction_types(m_random))
+            {
+                case 1:
+                {
+                    const auto tx = stake_transaction();
+
+                    generated.emplace_back(tx.hash(), tx);
+
+                    break;
+                }
+                case 2:
+                {
+                    const auto tx = recall_stake_transaction();
+
+                    generated.emplace_back(tx.hash(), tx);
+
+                    break;
+                }
+                default:
+                {
+                    const auto tx = normal_transaction();
+
+                    generated.emplace_back(tx.hash(), tx);
+
+                    break;
+                }
+            }
+        }
+
+        // the transactions must be supplied in the same order as the hashes in the block
+        std::sort(
+            generated.begin(),
+            generated.end(),
+            [](const auto &a, const auto &b) { return std::get<0>(a) < std::get<0>(b); });
+
+        std::vector<transaction_t> transactions;
+
+        transactions.reserve(generated.size());
+
+        for (const auto &[txn_hash, tx] : generated)
+        {
+            block.append_transaction_hash(txn_hash);
+
+            transactions.push_back(tx);
+        }
+
+        m_previous_blockhash = block.hash();
+
+        m_block_index++;
+
+        return {block, transactions};
+    }
+
+    committed_normal_transaction_t ChainGenerator::normal_transaction()
+    {
+        committed_normal_transaction_t tx;
+
+        fill(tx, m_inputs(m_random), m_outputs(m_random));
+
+        return tx;
+    }
+
+    size_t ChainGenerator::output_count() const
+    {
+        return m_outputs_generated;
+    }
+
+    crypto_public_key_t ChainGenerator::pool_point()
+    {
+        return m_pool_a[m_random() % m_pool_a.size()];
+    }
+
+    crypto_hash_t ChainGenerator::random_hash()
+    {
+        const auto value = m_random();
+
+        return Crypto::Hashing::sha3(&value, sizeof(value));
+    }
+
+    committed_recall_stake_transaction_t ChainGenerator::recall_stake_transaction()
+    {
+        committed_recall_stake_transaction_t tx;
+
+        if (!m_stakes.empty())
+        {
+            // recall a random earlier stake, swapping it to the back keeps the removal cheap
+            std::swap(m_stakes[m_random() % m_stakes.size()], m_stakes.back());
+
+            const auto stake = m_stakes.back();
+
+            m_stakes.pop_back();
+
+            tx.candidate_public_key = stake.candidate_public_key;
+
+            tx.staker_id = stake.staker_id;
+
+            tx.stake_amount = stake.amount;
+        }
+        else
+        {
+            tx.candidate_public_key = m_candidates[m_random() % m_candidates.size()];
+
+            tx.staker_id = random_hash();
+
+            tx.stake_amount = (1 + m_random() % 100) * STAKE_AMOUNT_UNIT;
+        }
+
+        // the view and spend signatures are left empty as they are never verified
+
+        fill(tx, 1 + m_random() % 2, Configuration::Transaction::MINIMUM_OUTPUTS);
+
+        return tx;
+    }
+
+    committed_stake_transaction_t ChainGenerator::stake_transaction()
+    {
+        committed_stake_transaction_t tx;
+
+        tx.candidate_public_key = m_candidates[m_random() % m_candidates.size()];
+
+        tx.staker_public_view_key = pool_point();
+
+        tx.staker_public_spend_key = pool_point();
+
+        tx.stake_amount = (1 + m_random() % 100) * STAKE_AMOUNT_UNIT;
+
+        fill(tx, m_inputs(m_random), Configuration::Transaction::MINIMUM_OUTPUTS);
+
+        // the staker ID is derived the same way as the staking engine derives it
+        serializer_t writer;
+
+        tx.staker_public_view_key.serialize(writer);
+
+        tx.staker_public_spend_key.serialize(writer);
+
+        m_stakes.push_back(
+            {tx.candidate_public_key, Crypto::Hashing::sha3(writer.data(), writer.size()), tx.stake_amount});
+
+        return tx;
+    }
+
+    size_t ChainGenerator::transaction_count() const
+    {
+        return m_transactions;
+    }
+
+    crypto_public_key_t ChainGenerator::unique_point()
+    {
+        const auto n = m_unique_points++;
+
+        return m_pool_a[n % POINT_POOL_SIZE] + m_pool_b[(n / POINT_POOL_SIZE) % POINT_POOL_SIZE];
+    }
+} // namespace Core
@@ -0,0 +1,207 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef CORE_CHAIN_GENERATOR_H
+#define CORE_CHAIN_GENERATOR_H
+
+#include "blockchain_storage.h"
+
+#include <config.h>
+#include <errors.h>
+#include <functional>
+#include <random>
+#include <types.h>
+
+using namespace Types::Blockchain;
+
+namespace Core
+{
+    /**
+     * The shape of the synthetic chain produced by the chain generator
+     */
+    struct chain_generator_config_t
+    {
+        uint64_t seed = 0x7475727463646e;
+
+        size_t transactions_per_block = 16;
+
+        // the relative weights of the transaction types that make up each block
+        size_t normal_weight = 90, stake_weight = 6, recall_stake_weight = 4;
+
+        // the number of candidates that synthetic stakes are spread across
+        size_t candidates = 100;
+
+        uint64_t first_timestamp = 1'600'000'000;
+
+        // whether the proof of work of each transaction is mined (very slow, see below)
+        bool mine = false;
+    };
+
+    /**
+     * Generates a deterministic synthetic chain for load testing the storage layer
+     *
+     * The blocks and transactions are valid in shape, meaning that they have realistic
+     * input (key image) and output counts, real curve points for every key, and fees that
+     * cover their size, but they carry no proofs: the signature and range proof hashes
+     * are random and the transactions are only mined if requested. As such, the chain
+     * may be written through put_block and read back by anything that does not verify
+     * proofs.
+     *
+     * Curve points are the most expensive part of generation, so a fixed pool of points
+     * is derived from the seed once; output keys are drawn from the pool (the amount
+     * makes every output unique) and key images are formed as the sum of two pool points
+     * so that every key image in a chain of tens of millions of outputs is unique.
+     *
+     * The same configuration always produces the same chain.
+     */
+    class ChainGenerator
+    {
+      public:
+        /**
+         * The callback receives the number of blocks written so far
+         */
+        typedef std::function<void(uint64_t)> progress_callback_t;
+
+        ChainGenerator(const chain_generator_config_t &config = chain_generator_config_t());
+
+        /**
+         * Returns the index of the next block that will be generated
+         *
+         * @return
+         */
+        [[nodiscard]] uint64_t block_index() const;
+
+        /**
+         * Generates the specified number of blocks and writes them to the storage using put_block
+         *
+         * The storage must be empty as the generated chain always starts at block zero
+         *
+         * @param storage
+         * @param count
+         * @param callback
+         * @param callback_interval the number of blocks between calls of the callback
+         * @return
+         */
+        Error generate(
+            std::shared_ptr<BlockchainStorage> &storage,
+            uint64_t count,
+            const progress_callback_t &callback = nullptr,
+            uint64_t callback_interval = 1'000);
+
+        /**
+         * Returns the number of key images generated so far
+         *
+         * @return
+         */
+        [[nodiscard]] size_t key_image_count() const;
+
+        /**
+         * Generates the next block and its transactions
+         *
+         * The transactions are returned in the order that put_block expects them
+         *
+         * @return
+         */
+        std::tuple<block_t, std::vector<transaction_t>> next_block();
+
+        /**
+         * Generates a normal transaction
+         *
+         * @return
+         */
+        committed_normal_transaction_t normal_transaction();
+
+        /**
+         * Returns the number of outputs generated so far
+         *
+         * @return
+         */
+        [[nodiscard]] size_t output_count() const;
+
+        /**
+         * Generates a recall stake transaction for a stake that was generated earlier, if
+         * there are no stakes left to recall, a stake that was never generated is recalled
+         *
+         * @return
+         */
+        committed_recall_stake_transaction_t recall_stake_transaction();
+
+        /**
+         * Generates a stake transaction for one of the candidates
+         *
+         * @return
+         */
+        committed_stake_transaction_t stake_transaction();
+
+        /**
+         * Returns the number of transactions (excluding the block reward) generated so far
+         *
+         * @return
+         */
+        [[nodiscard]] size_t transaction_count() const;
+
+      private:
+        struct stake_entry_t
+        {
+            crypto_public_key_t candidate_public_key;
+
+            crypto_hash_t staker_id;
+
+            uint64_t amount = 0;
+        };
+
+        /**
+         * Fills in the common fields of a user transaction, sets the fee, and mines it if requested
+         *
+         * @tparam T
+         * @param tx
+         * @param inputs
+         * @param outputs
+         */
+        template<typename T> void fill(T &tx, size_t inputs, size_t outputs);
+
+        /**
+         * Returns a random hash
+         *
+         * @return
+         */
+        crypto_hash_t random_hash();
+
+        /**
+         * Returns a random point from the pool
+         *
+         * @return
+         */
+        crypto_public_key_t pool_point();
+
+        /**
+         * Returns a point that has not been returned before
+         *
+         * @return
+         */
+        crypto_public_key_t unique_point();
+
+        chain_generator_config_t m_config;
+
+        std::mt19937_64 m_random;
+
+        std::vector<crypto_public_key_t> m_pool_a, m_pool_b;
+
+        std::vector<crypto_public_key_t> m_candidates;
+
+        std::vector<stake_entry_t> m_stakes;
+
+        std::discrete_distribution<size_t> m_transaction_types, m_inputs, m_outputs;
+
+        uint64_t m_block_index = 0;
+
+        crypto_hash_t m_previous_blockhash;
+
+        uint64_t m_unique_points = 0;
+
+        size_t m_transactions = 0, m_outputs_generated = 0, m_key_images = 0;
+    };
+} // namespace Core
+
+#endif // CORE_CHAIN_GENERATOR_H
@@ -0,0 +1,295 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "elector_selection.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Core
+{
+    void ElectorSelection::build()
+    {
+        m_candidates.clear();
+
+        m_scaled_weights.clear();
+
+        m_probabilities.clear();
+
+        m_aliases.clear();
+
+        m_scaled_total = 0;
+
+        m_stale = false;
+
+        if (m_weights.empty())
+        {
+            return;
+        }
+
+        const uint64_t count = m_weights.size();
+
+        std::vector<uint64_t> weights;
+
+        uint64_t total = 0;
+
+        for (const auto &[candidate, weight] : m_weights)
+        {
+            m_candidates.push_back(candidate);
+
+            weights.push_back(weight);
+
+            total += weight;
+        }
+
+        /**
+         * The alias table is built using integer arithmetic only so that it is identical
+         * on every node. To do so, each weight is multiplied by the number of candidates
+         * which requires that we scale the weights down until that product fits in 64-bits
+         */
+        uint8_t shift = 0;
+
+        while ((total >> shift) + count > std::numeric_limits<uint64_t>::max() / count)
+        {
+            shift++;
+        }
+
+        for (auto &weight : weights)
+        {
+            weight = std::max<uint64_t>(weight >> shift, 1);
+
+            m_scaled_total += weight;
+        }
+
+        m_scaled_weights = weights;
+
+        std::vector<uint64_t> scaled;
+
+        std::vector<size_t> small, large;
+
+        for (size_t i = 0; i < weights.size(); ++i)
+        {
+            scaled.push_back(weights[i] * count);
+
+            if (scaled[i] < m_scaled_total)
+            {
+                small.push_back(i);
+            }
+            else
+            {
+                large.push_back(i);
+            }
+        }
+
+        m_probabilities.resize(count, m_scaled_total);
+
+        m_aliases.resize(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_aliases[i] = i;
+        }
+
+        while (!small.empty() && !large.empty())
+        {
+            const auto lesser = small.back();
+
+            small.pop_back();
+
+            const auto greater = large.back();
+
+            large.pop_back();
+
+            m_probabilities[lesser] = scaled[lesser];
+
+            m_aliases[lesser] = greater;
+
+            // move the remainder of the column from the greater entry
+            scaled[greater] -= m_scaled_total - scaled[lesser];
+
+            if (scaled[greater] < m_scaled_total)
+            {
+                small.push_back(greater);
+            }
+            else
+            {
+                large.push_back(greater);
+            }
+        }
+    }
+
+    void ElectorSelection::clear()
+    {
+        std::scoped_lock lock(m_mutex);
+
+        m_weights.clear();
+
+        m_stale = true;
+    }
+
+    size_t ElectorSelection::draw(const crypto_hash_t &seed, uint64_t &counter) const
+    {
+        const auto [first, second] = random(seed, counter);
+
+        const auto column = first % m_candidates.size();
+
+        const auto coin = second % m_scaled_total;
+
+        return (coin < m_probabilities[column]) ? column : m_aliases[column];
+    }
+
+    size_t ElectorSelection::draw_remaining(
+        const crypto_hash_t &seed,
+        uint64_t &counter,
+        const std::vector<bool> &selected,
+        uint64_t remaining) const
+    {
+        auto coin = std::get<0>(random(seed, counter)) % remaining;
+
+        size_t last = 0;
+
+        for (size_t i = 0; i < m_candidates.size(); ++i)
+        {
+            if (selected[i])
+            {
+                continue;
+            }
+
+            if (coin < m_scaled_weights[i])
+            {
+                return i;
+            }
+
+            coin -= m_scaled_weights[i];
+
+            last = i;
+        }
+
+        // not reached as long as the remaining weight is that of the candidates not selected
+        return last;
+    }
+
+    std::tuple<std::vector<crypto_public_key_t>, std::vector<crypto_public_key_t>>
+        ElectorSelection::elect(const crypto_hash_t &seed, size_t producer_count, size_t validator_count)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        if (m_stale)
+        {
+            build();
+        }
+
+        uint64_t counter = 0;
+
+        std::vector<crypto_public_key_t> producers = Configuration::Consensus::PERMANENT_CANDIDATES,
+                                         validators = Configuration::Consensus::PERMANENT_CANDIDATES;
+
+        fill(seed, counter, producer_count, producers);
+
+        fill(seed, counter, validator_count, validators);
+
+        return {producers, validators};
+    }
+
+    void ElectorSelection::fill(
+        const crypto_hash_t &seed,
+        uint64_t &counter,
+        size_t count,
+        std::vector<crypto_public_key_t> &results) const
+    {
+        std::vector<bool> selected(m_candidates.size(), false);
+
+        uint64_t remaining = m_scaled_total;
+
+        size_t available = m_candidates.size();
+
+        // the permanent candidates already hold their seats
+        for (size_t i = 0; i < m_candidates.size(); ++i)
+        {
+            if (std::find(results.begin(), results.end(), m_candidates[i]) != results.end())
+            {
+                selected[i] = true;
+
+                remaining -= m_scaled_weights[i];
+
+                available--;
+            }
+        }
+
+        while (results.size() < count && available != 0)
+        {
+            auto index = draw(seed, counter);
+
+            /**
+             * Redrawing a candidate that was already selected keeps the draw in proportion to the
+             * stake that remains; if a few candidates hold most of the stake the redraws keep landing
+             * on them, so the seat is then drawn directly from the remaining stake instead
+             */
+            for (size_t redraws = 0; selected[index] && redraws < Configuration::Consensus::ELECTOR_MAXIMUM_REDRAWS;
+                 ++redraws)
+            {
+                index = draw(seed, counter);
+            }
+
+            if (selected[index])
+            {
+                index = draw_remaining(seed, counter, selected, remaining);
+            }
+
+            selected[index] = true;
+
+            remaining -= m_scaled_weights[index];
+
+            available--;
+
+            results.push_back(m_candidates[index]);
+        }
+    }
+
+    std::tuple<uint64_t, uint64_t> ElectorSelection::random(const crypto_hash_t &seed, uint64_t &counter)
+    {
+        serializer_t writer;
+
+        seed.serialize(writer);
+
+        writer.varint(counter++);
+
+        const auto hash = Crypto::Hashing::sha3(writer.data(), writer.size());
+
+        serializer_t hash_writer;
+
+        hash.serialize(hash_writer);
+
+        deserializer_t reader(hash_writer.vector());
+
+        const auto first = reader.uint64(false, true);
+
+        const auto second = reader.uint64(false, true);
+
+        return {first, second};
+    }
+
+    void ElectorSelection::set_weight(const crypto_public_key_t &candidate, uint64_t weight)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        if (weight == 0)
+        {
+            m_weights.erase(candidate);
+        }
+        else
+        {
+            m_weights[candidate] = weight;
+        }
+
+        m_stale = true;
+    }
+
+    size_t ElectorSelection::size() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_weights.size();
+    }
+} // namespace Core
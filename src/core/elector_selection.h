@@ -0,0 +1,153 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef CORE_ELECTOR_SELECTION_H
+#define CORE_ELECTOR_SELECTION_H
+
+#include <config.h>
+#include <crypto_types.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace Core
+{
+    /**
+     * Deterministic stake weighted selection of electors (producers & validators)
+     *
+     * Candidate weights are held in an ordered map and a Walker (Vose) alias table
+     * is built over them using integer arithmetic only so that every node arrives
+     * at the exact same table for the same set of weights. Weight updates between
+     * rounds only mark the table as stale; it is rebuilt (O(n)) the next time an
+     * election is performed and each draw thereafter is O(1).
+     *
+     * Electors are drawn without replacement: a draw that lands on a candidate that was
+     * already selected is redrawn, and once a seat has been redrawn too many times (a few
+     * candidates hold most of the stake) it is drawn directly from the stake of the
+     * remaining candidates. Either way every seat is filled in proportion to the stake of
+     * the candidates that remain.
+     *
+     * The random stream used for the draws is derived from the seed (previous block
+     * hash) by hashing the seed with an incrementing counter.
+     */
+    class ElectorSelection
+    {
+      public:
+        ElectorSelection() = default;
+
+        /**
+         * Removes all candidates from the selection engine
+         */
+        void clear();
+
+        /**
+         * Performs an election using the specified seed and returns the selected
+         * producers and validators
+         *
+         * The permanent candidates are always placed first in both sets and the
+         * remaining slots are filled by stake weighted draws without replacement.
+         * If there are not enough candidates to fill the requested counts, all of
+         * the available candidates are returned.
+         *
+         * @param seed
+         * @param producer_count
+         * @param validator_count
+         * @return [producers, validators]
+         */
+        std::tuple<std::vector<crypto_public_key_t>, std::vector<crypto_public_key_t>> elect(
+            const crypto_hash_t &seed,
+            size_t producer_count = Configuration::Consensus::ELECTOR_TARGET_COUNT,
+            size_t validator_count = Configuration::Consensus::ELECTOR_TARGET_COUNT);
+
+        /**
+         * Sets the weight of the specified candidate, a weight of zero removes
+         * the candidate from the selection engine
+         *
+         * @param candidate
+         * @param weight
+         */
+        void set_weight(const crypto_public_key_t &candidate, uint64_t weight);
+
+        /**
+         * Returns the number of weighted candidates
+         *
+         * @return
+         */
+        [[nodiscard]] size_t size() const;
+
+      private:
+        /**
+         * Rebuilds the alias table from the current weights
+         */
+        void build();
+
+        /**
+         * Draws a single candidate index from the alias table
+         *
+         * @param seed
+         * @param counter
+         * @return
+         */
+        [[nodiscard]] size_t draw(const crypto_hash_t &seed, uint64_t &counter) const;
+
+        /**
+         * Draws a single candidate index from the candidates that have not been selected
+         * by walking their cumulative weights
+         *
+         * @param seed
+         * @param counter
+         * @param selected
+         * @param remaining the total weight of the candidates that have not been selected
+         * @return
+         */
+        [[nodiscard]] size_t draw_remaining(
+            const crypto_hash_t &seed,
+            uint64_t &counter,
+            const std::vector<bool> &selected,
+            uint64_t remaining) const;
+
+        /**
+         * Fills the result vector with stake weighted draws (without replacement)
+         * until the requested count is reached or no candidates remain
+         *
+         * @param seed
+         * @param counter
+         * @param count
+         * @param results
+         */
+        void fill(
+            const crypto_hash_t &seed,
+            uint64_t &counter,
+            size_t count,
+            std::vector<crypto_public_key_t> &results) const;
+
+        /**
+         * Derives the next two random values of the stream
+         *
+         * @param seed
+         * @param counter
+         * @return
+         */
+        [[nodiscard]] static std::tuple<uint64_t, uint64_t> random(const crypto_hash_t &seed, uint64_t &counter);
+
+        std::map<crypto_public_key_t, uint64_t> m_weights;
+
+        std::vector<crypto_public_key_t> m_candidates;
+
+        // the weights of the candidates as scaled down to build the alias table
+        std::vector<uint64_t> m_scaled_weights;
+
+        std::vector<uint64_t> m_probabilities;
+
+        std::vector<size_t> m_aliases;
+
+        uint64_t m_scaled_total = 0;
+
+        bool m_stale = true;
+
+        mutable std::mutex m_mutex;
+    };
+} // namespace Core
+
+#endif // CORE_ELECTOR_SELECTION_H
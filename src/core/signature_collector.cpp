@@ -0,0 +1,198 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "signature_collector.h"
+
+namespace Core
+{
+    Error ValidatorSignatureCollector::add_signature(
+        const crypto_hash_t &digest,
+        const crypto_public_key_t &public_key,
+        const crypto_signature_t &signature)
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+
+            if (m_blocks.find(digest) == m_blocks.end())
+            {
+                return MAKE_ERROR(BLOCK_NOT_PENDING);
+            }
+
+            const auto [error, accepted] = screen(m_blocks.at(digest), public_key);
+
+            if (error || !accepted)
+            {
+                return error;
+            }
+        }
+
+        // verification is the expensive part so it happens without holding the lock
+        if (!Crypto::Signature::check_signature(digest, public_key, signature))
+        {
+            return MAKE_ERROR(BLOCK_INVALID_VALIDATOR_SIGNATURE);
+        }
+
+        block_t block;
+
+        quorum_callback_t callback;
+
+        {
+            std::scoped_lock lock(m_mutex);
+
+            // the block may have been forgotten while we were verifying the signature
+            if (m_blocks.find(digest) == m_blocks.end())
+            {
+                return MAKE_ERROR(BLOCK_NOT_PENDING);
+            }
+
+            auto &pending = m_blocks.at(digest);
+
+            // and the same signature may have arrived from another peer in the meantime
+            const auto [error, accepted] = screen(pending, public_key);
+
+            if (error || !accepted || !append(pending, public_key, signature))
+            {
+                return error;
+            }
+
+            block = pending.block;
+
+            callback = pending.callback;
+        }
+
+        // the callback runs outside of the lock so that it may call back into the collector
+        if (callback)
+        {
+            callback(block);
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    bool ValidatorSignatureCollector::append(
+        pending_block_t &pending,
+        const crypto_public_key_t &public_key,
+        const crypto_signature_t &signature)
+    {
+        pending.block.append_validator_signature(public_key, signature);
+
+        if (pending.finalized || pending.block.validator_signatures.size() < pending.required)
+        {
+            return false;
+        }
+
+        pending.finalized = true;
+
+        return true;
+    }
+
+    void ValidatorSignatureCollector::forget(const crypto_hash_t &digest)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        m_blocks.erase(digest);
+    }
+
+    std::tuple<bool, block_t> ValidatorSignatureCollector::get_block(const crypto_hash_t &digest) const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        if (m_blocks.find(digest) == m_blocks.end())
+        {
+            return {false, {}};
+        }
+
+        return {true, m_blocks.at(digest).block};
+    }
+
+    bool ValidatorSignatureCollector::has_quorum(const crypto_hash_t &digest) const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        if (m_blocks.find(digest) == m_blocks.end())
+        {
+            return false;
+        }
+
+        return m_blocks.at(digest).finalized;
+    }
+
+    std::tuple<Error, bool>
+        ValidatorSignatureCollector::screen(const pending_block_t &pending, const crypto_public_key_t &public_key)
+    {
+        // duplicates are dropped before we spend any time on verification
+        if (pending.block.validator_signatures.find(public_key) != pending.block.validator_signatures.end())
+        {
+            return {MAKE_ERROR(SUCCESS), false};
+        }
+
+        if (pending.validators.find(public_key) == pending.validators.end())
+        {
+            return {MAKE_ERROR(BLOCK_VALIDATOR_NOT_ELECTED), false};
+        }
+
+        // producer may not validate their own blocks
+        if (public_key == pending.block.producer_public_key)
+        {
+            return {MAKE_ERROR(BLOCK_VALIDATOR_NOT_ELECTED), false};
+        }
+
+        return {MAKE_ERROR(SUCCESS), true};
+    }
+
+    crypto_hash_t ValidatorSignatureCollector::watch(
+        const block_t &block,
+        const std::vector<crypto_public_key_t> &validators,
+        quorum_callback_t callback)
+    {
+        const auto digest = block.message_digest(BLOCK_DIGEST_VALIDATOR);
+
+        pending_block_t pending;
+
+        pending.block = block;
+
+        pending.block.validator_signatures.clear();
+
+        pending.validators = std::set<crypto_public_key_t>(validators.begin(), validators.end());
+
+        // round up so that we never finalize below the threshold
+        pending.required = std::max<size_t>(
+            (pending.validators.size() * Configuration::Consensus::VALIDATOR_THRESHOLD + 99) / 100, 1);
+
+        pending.callback = callback;
+
+        bool quorum = false;
+
+        // the pending block is not shared yet so the existing signatures are verified without the lock
+        for (const auto &[public_key, signature] : block.validator_signatures)
+        {
+            const auto [error, accepted] = screen(pending, public_key);
+
+            if (error || !accepted || !Crypto::Signature::check_signature(digest, public_key, signature))
+            {
+                continue;
+            }
+
+            quorum |= append(pending, public_key, signature);
+        }
+
+        {
+            std::scoped_lock lock(m_mutex);
+
+            if (m_blocks.find(digest) != m_blocks.end())
+            {
+                return digest;
+            }
+
+            m_blocks.insert({digest, pending});
+        }
+
+        if (quorum && callback)
+        {
+            callback(pending.block);
+        }
+
+        return digest;
+    }
+} // namespace Core
@@ -0,0 +1,139 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef CORE_SIGNATURE_COLLECTOR_H
+#define CORE_SIGNATURE_COLLECTOR_H
+
+#include <config.h>
+#include <errors.h>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <types.h>
+
+using namespace Types::Blockchain;
+
+namespace Core
+{
+    /**
+     * Collects validator signatures for blocks awaiting finalization
+     *
+     * Blocks are tracked by their validator digest (the message that validators sign)
+     * which is computed once when the block is registered. Each signature is verified
+     * exactly once as it arrives and outside of the lock; duplicates and signatures from
+     * keys outside of the elected validator set are discarded without verification. The
+     * quorum callback fires exactly once, the moment VALIDATOR_THRESHOLD percent of the
+     * elected validators have signed.
+     */
+    class ValidatorSignatureCollector
+    {
+      public:
+        /**
+         * The callback receives the block with the collected validator signatures appended
+         */
+        typedef std::function<void(const block_t &)> quorum_callback_t;
+
+        ValidatorSignatureCollector() = default;
+
+        /**
+         * Adds the validator signature for the block with the specified validator digest
+         *
+         * @param digest
+         * @param public_key
+         * @param signature
+         * @return
+         */
+        Error add_signature(
+            const crypto_hash_t &digest,
+            const crypto_public_key_t &public_key,
+            const crypto_signature_t &signature);
+
+        /**
+         * Stops collecting signatures for the block with the specified validator digest
+         *
+         * @param digest
+         */
+        void forget(const crypto_hash_t &digest);
+
+        /**
+         * Retrieves the block with the collected validator signatures appended
+         *
+         * @param digest
+         * @return [found, block]
+         */
+        [[nodiscard]] std::tuple<bool, block_t> get_block(const crypto_hash_t &digest) const;
+
+        /**
+         * Returns whether the block with the specified validator digest has reached quorum
+         *
+         * @param digest
+         * @return
+         */
+        [[nodiscard]] bool has_quorum(const crypto_hash_t &digest) const;
+
+        /**
+         * Starts collecting validator signatures for the block using the elected validators
+         * and returns the validator digest that the block is tracked by
+         *
+         * Any validator signatures already contained in the block are verified and counted
+         *
+         * @param block
+         * @param validators
+         * @param callback
+         * @return
+         */
+        crypto_hash_t watch(
+            const block_t &block,
+            const std::vector<crypto_public_key_t> &validators,
+            quorum_callback_t callback = nullptr);
+
+      private:
+        struct pending_block_t
+        {
+            block_t block;
+
+            std::set<crypto_public_key_t> validators;
+
+            size_t required = 0;
+
+            bool finalized = false;
+
+            quorum_callback_t callback;
+        };
+
+        /**
+         * Stores the already verified signature, must be called while holding the mutex
+         *
+         * Returns whether the block has just reached quorum
+         *
+         * @param pending
+         * @param public_key
+         * @param signature
+         * @return
+         */
+        static bool append(
+            pending_block_t &pending,
+            const crypto_public_key_t &public_key,
+            const crypto_signature_t &signature);
+
+        /**
+         * Checks whether the signature from the public key should be verified for the block,
+         * must be called while holding the mutex if the block is being tracked
+         *
+         * Duplicates are not an error but are not accepted either
+         *
+         * @param pending
+         * @param public_key
+         * @return [error, accepted]
+         */
+        static std::tuple<Error, bool> screen(const pending_block_t &pending, const crypto_public_key_t &public_key);
+
+        std::map<crypto_hash_t, pending_block_t> m_blocks;
+
+        mutable std::mutex m_mutex;
+    };
+} // namespace Core
+
+#endif // CORE_SIGNATURE_COLLECTOR_H
@@ -4,8 +4,55 @@
 
 #include "staking_engine.h"
 
+#include <limits>
+
+#define CURSOR_SEEK_STEPS 8
+
 static ThreadSafeMap<crypto_hash_t, std::shared_ptr<Core::StakingEngine>> instances;
 
+/**
+ * Moves the cursor forward to the specified key. The keys must be visited in ascending order
+ * so that a nearby key is reached by stepping the cursor rather than searching the tree again,
+ * the tree is only searched when the key is further away or the cursor is not yet positioned.
+ *
+ * @param cursor
+ * @param key
+ * @return [error, key, value] where LMDB_NOTFOUND indicates the key does not exist
+ */
+static std::tuple<Error, deserializer_t, deserializer_t>
+    seek_forward(std::unique_ptr<Database::LMDBCursor> &cursor, const serializer_t &key)
+{
+    const auto target = key.vector();
+
+    auto [error, r_key, r_value] = cursor->get(MDB_GET_CURRENT);
+
+    for (size_t step = 0; !error && step < CURSOR_SEEK_STEPS; ++step)
+    {
+        const auto current = r_key.unread_data();
+
+        if (current == target)
+        {
+            return {error, r_key, r_value};
+        }
+
+        if (current > target)
+        {
+            break;
+        }
+
+        std::tie(error, r_key, r_value) = cursor->get(MDB_NEXT);
+    }
+
+    std::tie(error, r_key, r_value) = cursor->get(key, MDB_SET_RANGE);
+
+    if (!error && r_key.unread_data() != target)
+    {
+        return {MAKE_ERROR(LMDB_NOTFOUND), r_key, r_value};
+    }
+
+    return {error, r_key, r_value};
+}
+
 namespace Core
 {
     StakingEngine::StakingEngine(const std::string &db_path)
@@ -17,6 +64,14 @@ namespace Core
         m_db_candidates = m_db_env->open_database("candidates");
 
         m_db_stakes = m_db_env->open_database("stakes", MDB_CREATE | MDB_DUPSORT);
+
+        m_db_tallies = m_db_env->open_database("tallies");
+
+        m_db_rewards = m_db_env->open_database("staker_rewards");
+
+        m_db_undo = m_db_env->open_database("staking_undo");
+
+        load_tallies();
     }
 
     StakingEngine::~StakingEngine()
@@ -27,7 +82,7 @@ namespace Core
         }
     }
 
-    Error StakingEngine::add_stake(const committed_stake_transaction_t &tx)
+    Error StakingEngine::add_stake(uint64_t block_index, const committed_stake_transaction_t &tx)
     {
         std::scoped_lock lock(write_mutex);
 
@@ -47,68 +102,979 @@ namespace Core
             {
                 return MAKE_ERROR(STAKING_CANDIDATE_AMOUNT_INVALID);
             }
+        }
+        else if (tx.version == 2)
+        {
+            if (!m_db_candidates->exists(tx.candidate_public_key))
+            {
+                return MAKE_ERROR(STAKING_CANDIDATE_NOT_FOUND);
+            }
+
+            if (tx.stake_amount < Configuration::Consensus::MINIMUM_STAKE_AMOUNT)
+            {
+                return MAKE_ERROR(STAKING_STAKE_AMOUNT);
+            }
+        }
+        else
+        {
+            return MAKE_ERROR(TX_INVALID_VERSION);
+        }
+
+        uint64_t total = 0;
+
+    try_again:
+
+        auto db_tx = m_db_env->transaction();
 
+        serializer_t key;
+
+        tx.candidate_public_key.serialize(key);
+
+        if (tx.version == 1)
+        {
             candidate_node_t candidate(
                 tx.candidate_public_key, tx.staker_public_view_key, tx.staker_public_spend_key, tx.stake_amount);
 
-            auto error = m_db_candidates->put(tx.candidate_public_key, candidate);
+            auto error = log_undo(db_tx, block_index, UNDO_CANDIDATES, key);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+
+            db_tx->set_database(m_db_candidates);
+
+            error = db_tx->put(tx.candidate_public_key, candidate);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
 
             if (error)
             {
                 return error;
             }
         }
-        else if (tx.version == 2)
+        else
         {
-            if (!m_db_candidates->exists(tx.candidate_public_key))
+            stake_t stake(tx.staker_public_view_key, tx.staker_public_spend_key, tx.stake_amount);
+
+            stake.candidate_public_key = tx.candidate_public_key;
+
+            auto error = log_undo(db_tx, block_index, UNDO_STAKES, UNDO_DUP_DELETE, key, stake.serialize());
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
             {
-                return MAKE_ERROR(STAKING_CANDIDATE_NOT_FOUND);
+                return error;
             }
 
-            if (tx.stake_amount < Configuration::Consensus::MINIMUM_STAKE_AMOUNT)
+            db_tx->set_database(m_db_stakes);
+
+            error = db_tx->put(tx.candidate_public_key, stake);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
             {
-                return MAKE_ERROR(STAKING_STAKE_AMOUNT);
+                return error;
+            }
+        }
+
+        // the tally is updated in the same transaction so that it can never drift from the stakes
+        {
+            auto [error, new_total] = update_tally(db_tx, block_index, tx.candidate_public_key, tx.stake_amount);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
             }
 
-            // TODO: finish
+            total = new_total;
         }
-        else
+
+        auto error = db_tx->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+        if (error)
         {
-            return MAKE_ERROR(TX_INVALID_VERSION);
+            return error;
         }
 
+        set_tally(tx.candidate_public_key, total);
+
         return MAKE_ERROR(SUCCESS);
     }
 
     Error StakingEngine::del_stake(
+        uint64_t block_index,
         const committed_recall_stake_transaction_t &recall_tx,
         const stake_refund_transaction_t &refund_tx)
     {
-        // TODO: finish
+        if (refund_tx.recall_stake_tx != recall_tx.hash())
+        {
+            return MAKE_ERROR(TX_RECALL_STAKE_TX_HASH);
+        }
+
+        std::scoped_lock lock(write_mutex);
+
+        /**
+         * Version 1 == recalling candidacy
+         * Version 2 == recalling a stake of a candidate (vote)
+         */
+
+        if (recall_tx.version != 1 && recall_tx.version != 2)
+        {
+            return MAKE_ERROR(TX_INVALID_VERSION);
+        }
+
+        uint64_t total = 0;
+
+    try_again:
+
+        auto db_tx = m_db_env->transaction();
+
+        serializer_t key;
+
+        recall_tx.candidate_public_key.serialize(key);
+
+        if (recall_tx.version == 1)
+        {
+            db_tx->set_database(m_db_candidates);
+
+            auto [error, candidate] = db_tx->get<candidate_node_t>(recall_tx.candidate_public_key);
+
+            if (error)
+            {
+                return MAKE_ERROR(STAKING_CANDIDATE_NOT_FOUND);
+            }
+
+            if (recall_tx.stake_amount != candidate.initial_stake)
+            {
+                return MAKE_ERROR(STAKING_CANDIDATE_AMOUNT_INVALID);
+            }
+
+            error = log_undo(db_tx, block_index, UNDO_CANDIDATES, key);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+
+            db_tx->set_database(m_db_candidates);
+
+            error = db_tx->del(recall_tx.candidate_public_key);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+
+            /**
+             * The votes for the candidate are removed along with it (and restored by a rewind) as
+             * the tally is removed below, a candidate that registers again starts without votes
+             */
+            std::vector<stake_t> votes;
+
+            {
+                db_tx->set_database(m_db_stakes);
+
+                auto cursor = db_tx->cursor();
+
+                auto [stakes_error, stakes_key, stakes] = cursor->get_all<stake_t>(recall_tx.candidate_public_key);
+
+                if (!stakes_error)
+                {
+                    votes = stakes;
+                }
+            }
+
+            for (const auto &vote : votes)
+            {
+                error = log_undo(db_tx, block_index, UNDO_STAKES, UNDO_DUP_RESTORE, key, vote.serialize());
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+
+                db_tx->set_database(m_db_stakes);
+
+                error = db_tx->del(recall_tx.candidate_public_key, vote);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+        }
+        else
+        {
+            db_tx->set_database(m_db_stakes);
+
+            stake_t found_stake;
+
+            bool found = false;
+
+            {
+                auto cursor = db_tx->cursor();
+
+                auto [error, key, stakes] = cursor->get_all<stake_t>(recall_tx.candidate_public_key);
+
+                for (const auto &stake : stakes)
+                {
+                    if (stake.id() == recall_tx.staker_id && stake.stake == recall_tx.stake_amount)
+                    {
+                        found_stake = stake;
+
+                        found = true;
+
+                        break;
+                    }
+                }
+            }
+
+            if (!found)
+            {
+                return MAKE_ERROR(STAKING_STAKER_NOT_FOUND);
+            }
+
+            auto error = log_undo(db_tx, block_index, UNDO_STAKES, UNDO_DUP_RESTORE, key, found_stake.serialize());
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+
+            db_tx->set_database(m_db_stakes);
+
+            error = db_tx->del(recall_tx.candidate_public_key, found_stake);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+        }
+
+        /**
+         * When candidacy is recalled the candidate no longer participates in elections
+         * so the entire tally is removed together with the votes
+         */
+        {
+            const auto amount =
+                (recall_tx.version == 1) ? std::numeric_limits<uint64_t>::max() : recall_tx.stake_amount;
+
+            auto [error, new_total] = update_tally(db_tx, block_index, recall_tx.candidate_public_key, amount, true);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+
+            total = new_total;
+        }
+
+        auto error = db_tx->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+        if (error)
+        {
+            return error;
+        }
+
+        set_tally(recall_tx.candidate_public_key, total);
 
         return MAKE_ERROR(SUCCESS);
     }
 
-    std::shared_ptr<StakingEngine> StakingEngine::instance(const std::string &db_path)
+    std::tuple<std::vector<crypto_public_key_t>, std::vector<crypto_public_key_t>>
+        StakingEngine::elect(const crypto_hash_t &previous_blockhash)
     {
-        const auto id = Crypto::Hashing::sha3(db_path.data(), db_path.size());
+        return m_elector_selection.elect(previous_blockhash);
+    }
 
-        if (!instances.contains(id))
+    uint64_t StakingEngine::get_candidate_stake(const crypto_public_key_t &candidate_public_key) const
+    {
+        std::scoped_lock lock(tally_mutex);
+
+        if (m_tallies.find(candidate_public_key) == m_tallies.end())
         {
-            auto db = new StakingEngine(db_path);
+            return 0;
+        }
 
-            auto ptr = std::shared_ptr<StakingEngine>(db);
+        return m_tallies.at(candidate_public_key);
+    }
 
-            instances.insert(id, ptr);
+    std::tuple<Error, uint64_t>
+        StakingEngine::get_candidate_stake(const crypto_public_key_t &candidate_public_key, uint64_t block_index)
+    {
+        uint64_t total = 0;
+
+        auto txn = m_db_env->transaction(true);
+
+        txn->set_database(m_db_tallies);
+
+        {
+            auto [error, value] = txn->get(candidate_public_key);
+
+            if (!error)
+            {
+                total = value.varint<uint64_t>();
+            }
         }
 
-        return instances.at(id);
+        serializer_t candidate_key;
+
+        candidate_public_key.serialize(candidate_key);
+
+        /**
+         * Walk the undo log backwards from the tip until we reach the requested height. Each
+         * undo entry holds the value prior to the change, so the last tally entry we see for
+         * the candidate is the value as of the requested height
+         */
+        txn->set_database(m_db_undo);
+
+        auto cursor = txn->cursor();
+
+        for (auto op = MDB_LAST;; op = MDB_PREV)
+        {
+            auto [error, key, value] = cursor->get(op);
+
+            if (error || key.uint64(false, true) <= block_index)
+            {
+                break;
+            }
+
+            const auto [table, operation, entry_key, entry_value] = read_undo(value);
+
+            if (table != UNDO_TALLIES || entry_key.to_string() != candidate_key.to_string())
+            {
+                continue;
+            }
+
+            if (operation == UNDO_DELETE)
+            {
+                total = 0;
+            }
+            else
+            {
+                deserializer_t reader(entry_value.vector());
+
+                total = reader.varint<uint64_t>();
+            }
+        }
+
+        return {MAKE_ERROR(SUCCESS), total};
     }
 
-    Error StakingEngine::process_staker_tx(const staker_transaction_t &tx)
+    std::tuple<Error, uint64_t, uint64_t> StakingEngine::get_staker_rewards(const crypto_hash_t &staker_id) const
     {
-        // TODO: finish
+        auto [error, reader] = m_db_rewards->get(staker_id);
 
-        return MAKE_ERROR(SUCCESS);
+        if (error)
+        {
+            return {error, 0, 0};
+        }
+
+        // record version
+        reader.varint<uint64_t>();
+
+        const auto rewards = reader.varint<uint64_t>();
+
+        const auto penalties = reader.varint<uint64_t>();
+
+        return {MAKE_ERROR(SUCCESS), rewards, penalties};
+    }
+
+    std::vector<std::tuple<crypto_public_key_t, uint64_t>> StakingEngine::get_top_candidates(size_t count) const
+    {
+        std::scoped_lock lock(tally_mutex);
+
+        std::vector<std::tuple<crypto_public_key_t, uint64_t>> results;
+
+        for (auto it = m_tally_index.rbegin(); it != m_tally_index.rend() && results.size() < count; ++it)
+        {
+            const auto &[total, candidate] = *it;
+
+            results.emplace_back(candidate, total);
+        }
+
+        return results;
+    }
+
+    std::shared_ptr<StakingEngine> StakingEngine::instance(const std::string &db_path)
+    {
+        const auto id = Crypto::Hashing::sha3(db_path.data(), db_path.size());
+
+        if (!instances.contains(id))
+        {
+            auto db = new StakingEngine(db_path);
+
+            auto ptr = std::shared_ptr<StakingEngine>(db);
+
+            instances.insert(id, ptr);
+        }
+
+        return instances.at(id);
+    }
+
+    void StakingEngine::load_tallies()
+    {
+        std::scoped_lock lock(tally_mutex);
+
+        m_tallies.clear();
+
+        m_tally_index.clear();
+
+        m_elector_selection.clear();
+
+        auto txn = m_db_tallies->transaction(true);
+
+        auto cursor = txn->cursor();
+
+        for (auto op = MDB_FIRST;; op = MDB_NEXT)
+        {
+            auto [error, key, value] = cursor->get(op);
+
+            if (error)
+            {
+                break;
+            }
+
+            const auto candidate = key.key<crypto_public_key_t>();
+
+            const auto total = value.varint<uint64_t>();
+
+            m_tallies[candidate] = total;
+
+            m_tally_index.insert({total, candidate});
+
+            m_elector_selection.set_weight(candidate, total);
+        }
+    }
+
+    Error StakingEngine::log_undo(
+        std::unique_ptr<Database::LMDBTransaction> &db_tx,
+        uint64_t block_index,
+        staking_undo_table_t table,
+        const serializer_t &key)
+    {
+        db_tx->set_database(undo_database(table));
+
+        auto [error, value] = db_tx->get(key);
+
+        if (error)
+        {
+            return log_undo(db_tx, block_index, table, UNDO_DELETE, key);
+        }
+
+        return log_undo(db_tx, block_index, table, UNDO_RESTORE, key, value.unread_data());
+    }
+
+    Error StakingEngine::log_undo(
+        std::unique_ptr<Database::LMDBTransaction> &db_tx,
+        uint64_t block_index,
+        staking_undo_table_t table,
+        staking_undo_operation_t operation,
+        const serializer_t &key,
+        const std::vector<uint8_t> &value)
+    {
+        serializer_t undo_key, undo_value;
+
+        undo_key.uint64(block_index, true);
+
+        undo_key.uint64(next_undo_sequence(db_tx, block_index), true);
+
+        undo_value.varint(table);
+
+        undo_value.varint(operation);
+
+        undo_value.varint(key.size());
+
+        undo_value.bytes(key.data(), key.size());
+
+        undo_value.varint(value.size());
+
+        undo_value.bytes(value.data(), value.size());
+
+        db_tx->set_database(m_db_undo);
+
+        return db_tx->put(undo_key, undo_value);
+    }
+
+    uint64_t
+        StakingEngine::next_undo_sequence(std::unique_ptr<Database::LMDBTransaction> &db_tx, uint64_t block_index)
+    {
+        db_tx->set_database(m_db_undo);
+
+        auto cursor = db_tx->cursor();
+
+        serializer_t next_block;
+
+        next_block.uint64(block_index + 1, true);
+
+        next_block.uint64(0, true);
+
+        /**
+         * The last entry of the block is the one before the first entry of the next block, the
+         * entries written earlier in the same transaction are included as they are visible to it
+         */
+        auto [error, key, value] = cursor->get(next_block, MDB_SET_RANGE);
+
+        std::tie(error, key, value) = cursor->get(error ? MDB_LAST : MDB_PREV);
+
+        if (error)
+        {
+            return 0;
+        }
+
+        const auto last_block_index = key.uint64(false, true);
+
+        const auto last_sequence = key.uint64(false, true);
+
+        return (last_block_index == block_index) ? last_sequence + 1 : 0;
+    }
+
+    Error StakingEngine::process_staker_tx(
+        uint64_t block_index,
+        const staker_transaction_t &tx,
+        const crypto_public_key_t &producer_public_key,
+        const std::vector<crypto_public_key_t> &validator_public_keys)
+    {
+        /**
+         * Group the outputs & penalties by staker first, the map keeps them sorted by
+         * staker ID which is also the key order of the database so the cursor moves
+         * through the tree in one direction
+         */
+        std::map<crypto_hash_t, std::tuple<uint64_t, uint64_t>> changes;
+
+        for (const auto &output : tx.staker_outputs)
+        {
+            std::get<0>(changes[output.staker_id]) += output.amount;
+        }
+
+        for (const auto &penalty : tx.staker_penalties)
+        {
+            std::get<1>(changes[penalty.staker_id]) += penalty.amount;
+        }
+
+        // tally the block production and validation counts per candidate
+        std::map<crypto_public_key_t, std::tuple<uint64_t, uint64_t>> counters;
+
+        if (!producer_public_key.empty())
+        {
+            std::get<0>(counters[producer_public_key])++;
+        }
+
+        for (const auto &validator : validator_public_keys)
+        {
+            std::get<1>(counters[validator])++;
+        }
+
+        std::scoped_lock lock(write_mutex);
+
+    try_again:
+
+        auto db_tx = m_db_env->transaction();
+
+        {
+            db_tx->set_database(m_db_rewards);
+
+            auto cursor = db_tx->cursor();
+
+            for (const auto &[staker_id, change] : changes)
+            {
+                const auto &[reward, penalty] = change;
+
+                serializer_t key;
+
+                staker_id.serialize(key);
+
+                uint64_t rewards = 0, penalties = 0;
+
+                {
+                    auto [error, r_key, r_value] = seek_forward(cursor, key);
+
+                    if (!error)
+                    {
+                        error = log_undo(db_tx, block_index, UNDO_REWARDS, UNDO_RESTORE, key, r_value.unread_data());
+
+                        // record version
+                        r_value.varint<uint64_t>();
+
+                        rewards = r_value.varint<uint64_t>();
+
+                        penalties = r_value.varint<uint64_t>();
+                    }
+                    else
+                    {
+                        error = log_undo(db_tx, block_index, UNDO_REWARDS, UNDO_DELETE, key);
+                    }
+
+                    MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                    if (error)
+                    {
+                        return error;
+                    }
+                }
+
+                serializer_t value;
+
+                value.varint(Configuration::Staking::STAKER_RECORD_VERSION);
+
+                value.varint(rewards + reward);
+
+                value.varint(penalties + penalty);
+
+                auto error = cursor->put(key, value);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+        }
+
+        {
+            db_tx->set_database(m_db_candidates);
+
+            auto cursor = db_tx->cursor();
+
+            for (const auto &[candidate_public_key, counter] : counters)
+            {
+                const auto &[produced, validated] = counter;
+
+                serializer_t key;
+
+                candidate_public_key.serialize(key);
+
+                auto [error, r_key, r_value] = seek_forward(cursor, key);
+
+                if (error)
+                {
+                    return MAKE_ERROR(STAKING_CANDIDATE_NOT_FOUND);
+                }
+
+                error = log_undo(db_tx, block_index, UNDO_CANDIDATES, UNDO_RESTORE, key, r_value.unread_data());
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+
+                candidate_node_t candidate(r_value);
+
+                candidate.blocks_produced += produced;
+
+                candidate.blocks_validated += validated;
+
+                serializer_t value;
+
+                candidate.serialize(value);
+
+                error = cursor->put(key, value);
+
+                MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+                if (error)
+                {
+                    return error;
+                }
+            }
+        }
+
+        auto error = db_tx->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+        return error;
+    }
+
+    Error StakingEngine::prune_undo_log(uint64_t block_index)
+    {
+        std::scoped_lock lock(write_mutex);
+
+    try_again:
+
+        auto db_tx = m_db_env->transaction();
+
+        db_tx->set_database(m_db_undo);
+
+        std::vector<serializer_t> keys;
+
+        {
+            auto cursor = db_tx->cursor();
+
+            for (auto op = MDB_FIRST;; op = MDB_NEXT)
+            {
+                auto [error, key, value] = cursor->get(op);
+
+                if (error)
+                {
+                    break;
+                }
+
+                const serializer_t undo_key(key.unread_data());
+
+                if (key.uint64(false, true) >= block_index)
+                {
+                    break;
+                }
+
+                keys.push_back(undo_key);
+            }
+        }
+
+        for (const auto &key : keys)
+        {
+            auto error = db_tx->del(key);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+        }
+
+        auto error = db_tx->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+        return error;
+    }
+
+    std::tuple<staking_undo_table_t, staking_undo_operation_t, serializer_t, serializer_t>
+        StakingEngine::read_undo(deserializer_t &reader)
+    {
+        const auto table = static_cast<staking_undo_table_t>(reader.varint<uint64_t>());
+
+        const auto operation = static_cast<staking_undo_operation_t>(reader.varint<uint64_t>());
+
+        const auto key = serializer_t(reader.bytes(reader.varint<uint64_t>()));
+
+        const auto value = serializer_t(reader.bytes(reader.varint<uint64_t>()));
+
+        return {table, operation, key, value};
+    }
+
+    Error StakingEngine::rewind(uint64_t block_index)
+    {
+        std::scoped_lock lock(write_mutex);
+
+    try_again:
+
+        auto db_tx = m_db_env->transaction();
+
+        db_tx->set_database(m_db_undo);
+
+        // collect the undo entries above the requested height from the newest to the oldest
+        std::vector<std::tuple<serializer_t, deserializer_t>> entries;
+
+        {
+            auto cursor = db_tx->cursor();
+
+            for (auto op = MDB_LAST;; op = MDB_PREV)
+            {
+                auto [error, key, value] = cursor->get(op);
+
+                if (error)
+                {
+                    break;
+                }
+
+                const serializer_t undo_key(key.unread_data());
+
+                if (key.uint64(false, true) <= block_index)
+                {
+                    break;
+                }
+
+                entries.emplace_back(undo_key, value);
+            }
+        }
+
+        for (auto &[undo_key, value] : entries)
+        {
+            const auto [table, operation, key, entry_value] = read_undo(value);
+
+            db_tx->set_database(undo_database(table));
+
+            Error error;
+
+            switch (operation)
+            {
+                case UNDO_RESTORE:
+                case UNDO_DUP_RESTORE:
+                    error = db_tx->put(key, entry_value);
+                    break;
+                case UNDO_DELETE:
+                    error = db_tx->del(key);
+                    break;
+                case UNDO_DUP_DELETE:
+                    error = db_tx->del(key, entry_value);
+                    break;
+            }
+
+            if (error == LMDB_NOTFOUND)
+            {
+                error = MAKE_ERROR(SUCCESS);
+            }
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+
+            db_tx->set_database(m_db_undo);
+
+            error = db_tx->del(undo_key);
+
+            MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+            if (error)
+            {
+                return error;
+            }
+        }
+
+        auto error = db_tx->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, m_db_env, db_tx, try_again);
+
+        if (error)
+        {
+            return error;
+        }
+
+        load_tallies();
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    void StakingEngine::set_tally(const crypto_public_key_t &candidate_public_key, uint64_t total)
+    {
+        std::scoped_lock lock(tally_mutex);
+
+        if (m_tallies.find(candidate_public_key) != m_tallies.end())
+        {
+            m_tally_index.erase({m_tallies.at(candidate_public_key), candidate_public_key});
+
+            m_tallies.erase(candidate_public_key);
+        }
+
+        if (total != 0)
+        {
+            m_tallies[candidate_public_key] = total;
+
+            m_tally_index.insert({total, candidate_public_key});
+        }
+
+        // the selection engine only rebuilds its alias table at the next election
+        m_elector_selection.set_weight(candidate_public_key, total);
+    }
+
+    std::tuple<Error, uint64_t> StakingEngine::update_tally(
+        std::unique_ptr<Database::LMDBTransaction> &db_tx,
+        uint64_t block_index,
+        const crypto_public_key_t &candidate_public_key,
+        uint64_t amount,
+        bool subtract)
+    {
+        serializer_t key;
+
+        candidate_public_key.serialize(key);
+
+        {
+            auto error = log_undo(db_tx, block_index, UNDO_TALLIES, key);
+
+            if (error)
+            {
+                return {error, 0};
+            }
+        }
+
+        db_tx->set_database(m_db_tallies);
+
+        uint64_t total = 0;
+
+        {
+            auto [error, value] = db_tx->get(candidate_public_key);
+
+            if (!error)
+            {
+                total = value.varint<uint64_t>();
+            }
+        }
+
+        if (subtract)
+        {
+            total = (amount > total) ? 0 : total - amount;
+        }
+        else
+        {
+            total += amount;
+        }
+
+        if (total == 0)
+        {
+            auto error = db_tx->del(candidate_public_key);
+
+            if (error && error != LMDB_NOTFOUND)
+            {
+                return {error, 0};
+            }
+
+            return {MAKE_ERROR(SUCCESS), 0};
+        }
+
+        serializer_t writer;
+
+        writer.varint(total);
+
+        auto error = db_tx->put(candidate_public_key, writer);
+
+        return {error, total};
+    }
+
+    std::shared_ptr<Database::LMDBDatabase> &StakingEngine::undo_database(staking_undo_table_t table)
+    {
+        switch (table)
+        {
+            case UNDO_CANDIDATES:
+                return m_db_candidates;
+            case UNDO_STAKES:
+                return m_db_stakes;
+            case UNDO_TALLIES:
+                return m_db_tallies;
+            default:
+                return m_db_rewards;
+        }
     }
 } // namespace Core
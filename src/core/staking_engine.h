@@ -5,7 +5,10 @@
 #ifndef CORE_STAKING_ENGINE_H
 #define CORE_STAKING_ENGINE_H
 
+#include "elector_selection.h"
+
 #include <db_lmdb.h>
+#include <set>
 #include <types.h>
 
 using namespace Types::Staking;
@@ -13,8 +16,28 @@ using namespace Types::Blockchain;
 
 namespace Core
 {
+    enum staking_undo_table_t
+    {
+        UNDO_CANDIDATES,
+        UNDO_STAKES,
+        UNDO_TALLIES,
+        UNDO_REWARDS
+    };
+
+    enum staking_undo_operation_t
+    {
+        UNDO_RESTORE,
+        UNDO_DELETE,
+        UNDO_DUP_DELETE,
+        UNDO_DUP_RESTORE
+    };
+
     /**
      * Represents the core staking engine
+     *
+     * Every change made to the staking tables is recorded in an undo log keyed by the
+     * block index at which the change was made. Rewinding the staking state or querying
+     * it at a past height therefore only touches the changes made after that height.
      */
     class StakingEngine
     {
@@ -29,12 +52,78 @@ namespace Core
       public:
         ~StakingEngine();
 
-        Error add_stake(const committed_stake_transaction_t &tx);
+        /**
+         * Adds the stake to the database and updates the vote tally of the
+         * candidate in the same database transaction
+         *
+         * @param block_index
+         * @param tx
+         * @return
+         */
+        Error add_stake(uint64_t block_index, const committed_stake_transaction_t &tx);
 
+        /**
+         * Removes the stake from the database and updates the vote tally of the
+         * candidate in the same database transaction
+         *
+         * Recalling candidacy also removes the votes for the candidate along with its tally
+         *
+         * @param block_index
+         * @param recall_tx
+         * @param refund_tx
+         * @return
+         */
         Error del_stake(
+            uint64_t block_index,
             const committed_recall_stake_transaction_t &recall_tx,
             const stake_refund_transaction_t &refund_tx);
 
+        /**
+         * Performs the stake weighted election of the producers and validators for the
+         * next round using the previous block hash as the seed
+         *
+         * @param previous_blockhash
+         * @return [producers, validators]
+         */
+        std::tuple<std::vector<crypto_public_key_t>, std::vector<crypto_public_key_t>>
+            elect(const crypto_hash_t &previous_blockhash);
+
+        /**
+         * Retrieves the total amount staked to the specified candidate
+         *
+         * @param candidate_public_key
+         * @return
+         */
+        [[nodiscard]] uint64_t get_candidate_stake(const crypto_public_key_t &candidate_public_key) const;
+
+        /**
+         * Retrieves the total amount staked to the specified candidate as of the
+         * specified block index using the undo log
+         *
+         * @param candidate_public_key
+         * @param block_index
+         * @return
+         */
+        [[nodiscard]] std::tuple<Error, uint64_t>
+            get_candidate_stake(const crypto_public_key_t &candidate_public_key, uint64_t block_index);
+
+        /**
+         * Retrieves the accumulated rewards and penalties of the specified staker
+         *
+         * @param staker_id
+         * @return [error, rewards, penalties]
+         */
+        [[nodiscard]] std::tuple<Error, uint64_t, uint64_t> get_staker_rewards(const crypto_hash_t &staker_id) const;
+
+        /**
+         * Retrieves up to the specified number of candidates ordered by their total
+         * stake (descending) from the in-memory tally index
+         *
+         * @param count
+         * @return
+         */
+        [[nodiscard]] std::vector<std::tuple<crypto_public_key_t, uint64_t>> get_top_candidates(size_t count) const;
+
         /**
          * Retrieves a singleton instance of the class
          *
@@ -43,16 +132,161 @@ namespace Core
          */
         static std::shared_ptr<StakingEngine> instance(const std::string &db_path);
 
-        Error process_staker_tx(const staker_transaction_t &tx);
+        /**
+         * Applies the staker rewards & penalties of the staker transaction and updates
+         * the production/validation counters of the candidates that produced and
+         * validated the block as a single batch
+         *
+         * Outputs are grouped by staker and then written in sorted key order with a
+         * single cursor inside one write transaction so that the cost is one write
+         * per distinct staker rather than one per output. The cursor steps forward
+         * to the next staker and only searches the tree when the next staker is not
+         * close by.
+         *
+         * @param block_index
+         * @param tx
+         * @param producer_public_key
+         * @param validator_public_keys
+         * @return
+         */
+        Error process_staker_tx(
+            uint64_t block_index,
+            const staker_transaction_t &tx,
+            const crypto_public_key_t &producer_public_key,
+            const std::vector<crypto_public_key_t> &validator_public_keys);
+
+        /**
+         * Removes the undo log entries for changes made before the given block index;
+         * the staking state can no longer be rewound past that block index
+         *
+         * @param block_index
+         * @return
+         */
+        Error prune_undo_log(uint64_t block_index);
+
+        /**
+         * Rewinds the staking state to the given block index by applying the undo log
+         * entries of the blocks above it in reverse order
+         *
+         * @param block_index
+         * @return
+         */
+        Error rewind(uint64_t block_index);
 
       private:
+        /**
+         * Loads the in-memory tally index from the tallies database
+         */
+        void load_tallies();
+
+        /**
+         * Records the current value (or absence) of the key in the specified table
+         * in the undo log using the provided database transaction
+         *
+         * @param db_tx
+         * @param block_index
+         * @param table
+         * @param key
+         * @return
+         */
+        Error log_undo(
+            std::unique_ptr<Database::LMDBTransaction> &db_tx,
+            uint64_t block_index,
+            staking_undo_table_t table,
+            const serializer_t &key);
+
+        /**
+         * Records the undo operation in the undo log using the provided database transaction
+         *
+         * @param db_tx
+         * @param block_index
+         * @param table
+         * @param operation
+         * @param key
+         * @param value
+         * @return
+         */
+        Error log_undo(
+            std::unique_ptr<Database::LMDBTransaction> &db_tx,
+            uint64_t block_index,
+            staking_undo_table_t table,
+            staking_undo_operation_t operation,
+            const serializer_t &key,
+            const std::vector<uint8_t> &value = {});
+
+        /**
+         * Returns the next sequence number of the undo log entries of the specified block index
+         * so that entries written to the block out of order never overwrite an existing entry
+         *
+         * @param db_tx
+         * @param block_index
+         * @return
+         */
+        uint64_t next_undo_sequence(std::unique_ptr<Database::LMDBTransaction> &db_tx, uint64_t block_index);
+
+        /**
+         * Decodes an undo log entry
+         *
+         * @param reader
+         * @return [table, operation, key, value]
+         */
+        static std::tuple<staking_undo_table_t, staking_undo_operation_t, serializer_t, serializer_t>
+            read_undo(deserializer_t &reader);
+
+        /**
+         * Updates the in-memory tally index for the specified candidate
+         *
+         * @param candidate_public_key
+         * @param total
+         */
+        void set_tally(const crypto_public_key_t &candidate_public_key, uint64_t total);
+
+        /**
+         * Adds (or subtracts) the amount to the tally of the specified candidate using
+         * the provided database transaction and returns the resulting total
+         *
+         * If the resulting total is zero, the tally is removed from the database
+         *
+         * @param db_tx
+         * @param block_index
+         * @param candidate_public_key
+         * @param amount
+         * @param subtract
+         * @return
+         */
+        std::tuple<Error, uint64_t> update_tally(
+            std::unique_ptr<Database::LMDBTransaction> &db_tx,
+            uint64_t block_index,
+            const crypto_public_key_t &candidate_public_key,
+            uint64_t amount,
+            bool subtract = false);
+
+        /**
+         * Returns the database handle for the specified undo table
+         *
+         * @param table
+         * @return
+         */
+        std::shared_ptr<Database::LMDBDatabase> &undo_database(staking_undo_table_t table);
+
         std::shared_ptr<Database::LMDB> m_db_env;
 
-        std::shared_ptr<Database::LMDBDatabase> m_db_candidates, m_db_stakes;
+        std::shared_ptr<Database::LMDBDatabase> m_db_candidates, m_db_stakes, m_db_tallies, m_db_rewards,
+            m_db_undo;
 
         crypto_hash_t m_id;
 
         std::mutex write_mutex;
+
+        mutable std::mutex tally_mutex;
+
+        // candidate => total stake
+        std::map<crypto_public_key_t, uint64_t> m_tallies;
+
+        // (total stake, candidate) ordered ascending; iterate in reverse for the top candidates
+        std::set<std::tuple<uint64_t, crypto_public_key_t>> m_tally_index;
+
+        ElectorSelection m_elector_selection;
     };
 } // namespace Core
 
@@ -28,9 +28,29 @@ namespace Core
 {
     TransactionValidator::TransactionValidator(
         std::shared_ptr<BlockchainStorage> &db,
-        std::shared_ptr<StakingEngine> &se):
-        m_blockchain_storage(db), m_staking_engine(se)
+        std::shared_ptr<StakingEngine> &se,
+        std::shared_ptr<VerifiedCache> verified_cache):
+        m_blockchain_storage(db),
+        m_staking_engine(se),
+        m_assume_valid_hash(Configuration::Consensus::ASSUME_VALID_BLOCK_HASH),
+        m_assume_valid_index(Configuration::Consensus::ASSUME_VALID_BLOCK_INDEX),
+        m_verified_cache(std::move(verified_cache))
     {
+        if (!m_verified_cache)
+        {
+            m_verified_cache = std::make_shared<VerifiedCache>();
+        }
+    }
+
+    bool TransactionValidator::assume_valid(uint64_t block_index) const
+    {
+        // the genesis block is always checked so that there is a verified block to rewind to
+        return !m_assume_valid_hash.empty() && block_index != 0 && block_index < m_assume_valid_index;
+    }
+
+    bool TransactionValidator::assume_valid_checkpoint(uint64_t block_index, const crypto_hash_t &block_hash) const
+    {
+        return !m_assume_valid_hash.empty() && block_index == m_assume_valid_index && block_hash == m_assume_valid_hash;
     }
 
     Error TransactionValidator::check(const uncommitted_transaction_t &transaction) const
@@ -64,7 +84,7 @@ namespace Core
             transaction);
     }
 
-    Error TransactionValidator::check(const transaction_t &transaction) const
+    Error TransactionValidator::check(const transaction_t &transaction, bool assume_valid) const
     {
         auto error = std::visit([&](auto &&tx) { return tx.check_construction(); }, transaction);
 
@@ -78,6 +98,12 @@ namespace Core
             {
                 USEVARIANT(T, tx);
 
+                // structural checks above still apply to transactions that are assumed valid
+                if (assume_valid)
+                {
+                    return MAKE_ERROR(SUCCESS);
+                }
+
                 if COMMITED_USER_TX_VARIANT (T)
                 {
                     const auto pow_zeros = tx.pow_hash().leading_zeros();
@@ -159,8 +185,33 @@ namespace Core
             transaction);
     }
 
+    Error TransactionValidator::check_assume_valid(uint64_t block_index, const crypto_hash_t &block_hash) const
+    {
+        if (!m_assume_valid_hash.empty() && block_index == m_assume_valid_index && block_hash != m_assume_valid_hash)
+        {
+            return MAKE_ERROR(BLOCK_ASSUME_VALID_MISMATCH);
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    void TransactionValidator::set_assume_valid(const crypto_hash_t &block_hash, uint64_t block_index)
+    {
+        m_assume_valid_hash = block_hash;
+
+        m_assume_valid_index = block_index;
+    }
+
     Error TransactionValidator::validate(uint64_t block_index, const uncommitted_transaction_t &transaction) const
     {
+        const auto txn_hash = std::visit([](auto &&tx) { return tx.hash(); }, transaction);
+
+        /**
+         * The range proof and ring signatures only depend upon the transaction itself and the ring
+         * members it commits to; if they have already passed, only the state dependent checks remain
+         */
+        const auto verified = m_verified_cache->contains(txn_hash);
+
         // first thing first, check the construction of the transaction
         auto error = check(transaction);
 
@@ -169,7 +220,7 @@ namespace Core
             return error;
         }
 
-        return std::visit(
+        error = std::visit(
             [&](auto &&tx)
             {
                 USEVARIANT(T, tx);
@@ -185,7 +236,7 @@ namespace Core
                 }
 
                 // verify the range proof
-                if (!Crypto::RangeProofs::BulletproofsPlus::verify(tx.range_proof, commitments))
+                if (!verified && !Crypto::RangeProofs::BulletproofsPlus::verify(tx.range_proof, commitments))
                 {
                     return MAKE_ERROR(TX_INVALID_RANGE_PROOF);
                 }
@@ -224,7 +275,7 @@ namespace Core
                 }
 
                 // now loop through the signatures and verify them
-                for (size_t i = 0; i < tx.signatures.size(); ++i)
+                for (size_t i = 0; !verified && i < tx.signatures.size(); ++i)
                 {
                     const auto &signature = tx.signatures[i];
 
@@ -246,12 +297,57 @@ namespace Core
                 return MAKE_ERROR(SUCCESS);
             },
             transaction);
+
+        if (!error && !verified)
+        {
+            m_verified_cache->add(txn_hash, block_index);
+        }
+
+        return error;
     }
 
     Error TransactionValidator::validate(uint64_t block_index, const transaction_t &transaction) const
     {
+        return validate(block_index, transaction, true);
+    }
+
+    Error TransactionValidator::validate(uint64_t block_index, const std::vector<transaction_t> &transactions) const
+    {
+        // conflicts within the block fail fast without any database access
+        const auto [error, key_images] = BlockchainStorage::collect_key_images(transactions);
+
+        if (error)
+        {
+            return error;
+        }
+
+        if (m_blockchain_storage->key_image_exists(key_images))
+        {
+            return MAKE_ERROR(TX_KEY_IMAGE_ALREADY_EXISTS);
+        }
+
+        for (const auto &transaction : transactions)
+        {
+            auto tx_error = validate(block_index, transaction, false);
+
+            if (tx_error)
+            {
+                return tx_error;
+            }
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    Error TransactionValidator::validate(
+        uint64_t block_index,
+        const transaction_t &transaction,
+        bool check_key_images) const
+    {
+        const auto txn_hash = std::visit([](auto &&tx) { return tx.hash(); }, transaction);
+
         // first thing first, check the construction of the transaction
-        auto error = check(transaction);
+        auto error = check(transaction, assume_valid(block_index) || m_verified_cache->contains(txn_hash));
 
         if (error)
         {
@@ -266,7 +362,7 @@ namespace Core
                 if COMMITED_USER_TX_VARIANT (T)
                 {
                     // check for double spends via key image checks
-                    if (m_blockchain_storage->key_image_exists(tx.key_images))
+                    if (check_key_images && m_blockchain_storage->key_image_exists(tx.key_images))
                     {
                         return MAKE_ERROR(TX_KEY_IMAGE_ALREADY_EXISTS);
                     }
@@ -296,4 +392,9 @@ namespace Core
             },
             transaction);
     }
+
+    std::shared_ptr<VerifiedCache> TransactionValidator::verified_cache() const
+    {
+        return m_verified_cache;
+    }
 } // namespace Core
@@ -7,6 +7,7 @@
 
 #include "blockchain_storage.h"
 #include "staking_engine.h"
+#include "verified_cache.h"
 
 #include <errors.h>
 #include <logger.h>
@@ -19,15 +20,53 @@ namespace Core
     class TransactionValidator
     {
       public:
-        TransactionValidator(std::shared_ptr<BlockchainStorage> &db, std::shared_ptr<StakingEngine> &se);
+        /**
+         * Constructs a new instance of the transaction validator; validators that share
+         * the verified cache (e.g. the transaction pool and block validation) do not
+         * repeat the cryptographic checks of transactions that another already verified
+         *
+         * @param db
+         * @param se
+         * @param verified_cache
+         */
+        TransactionValidator(
+            std::shared_ptr<BlockchainStorage> &db,
+            std::shared_ptr<StakingEngine> &se,
+            std::shared_ptr<VerifiedCache> verified_cache = nullptr);
+
+        /**
+         * Returns whether the block at the specified index is below the assume valid
+         * checkpoint and thus may skip the expensive cryptographic checks
+         *
+         * The blocks are only provisionally valid until the block at the checkpoint index
+         * arrives with the checkpoint hash and thereby proves that they are its ancestors;
+         * the genesis block is never assumed valid
+         *
+         * @param block_index
+         * @return
+         */
+        [[nodiscard]] bool assume_valid(uint64_t block_index) const;
+
+        /**
+         * Returns whether the block is the assume valid checkpoint block itself
+         *
+         * @param block_index
+         * @param block_hash
+         * @return
+         */
+        [[nodiscard]] bool assume_valid_checkpoint(uint64_t block_index, const crypto_hash_t &block_hash) const;
 
         /**
          * Performs basic construction checks of the provided transaction
          *
+         * If the transaction is assumed valid, the proof of work (and the fee that
+         * depends upon it) and the genesis output derivations are not verified
+         *
          * @param transaction
+         * @param assume_valid
          * @return
          */
-        [[nodiscard]] Error check(const transaction_t &transaction) const;
+        [[nodiscard]] Error check(const transaction_t &transaction, bool assume_valid = false) const;
 
         /**
          * Performs basic construction checks of the provided transaction
@@ -37,9 +76,30 @@ namespace Core
          */
         [[nodiscard]] Error check(const uncommitted_transaction_t &transaction) const;
 
+        /**
+         * Verifies that the block hash matches the assume valid checkpoint if the block
+         * is located at the checkpoint index
+         *
+         * @param block_index
+         * @param block_hash
+         * @return
+         */
+        [[nodiscard]] Error check_assume_valid(uint64_t block_index, const crypto_hash_t &block_hash) const;
+
+        /**
+         * Sets the assume valid checkpoint, an empty hash disables the checkpoint
+         *
+         * @param block_hash
+         * @param block_index
+         */
+        void set_assume_valid(const crypto_hash_t &block_hash, uint64_t block_index);
+
         /**
          * Performs full validation of the transaction
          *
+         * The proof of work is not verified again if the transaction was previously
+         * verified in its uncommitted form
+         *
          * @param transaction
          * @return
          */
@@ -48,15 +108,58 @@ namespace Core
         /**
          * Performs full validation of the transaction
          *
+         * Transactions that pass are recorded in the verified cache; if the transaction
+         * is already in the cache its range proof and ring signatures are not verified
+         * again, but the ring members are still retrieved and checked against the block index
+         *
          * @param transaction
          * @return
          */
         [[nodiscard]] Error validate(uint64_t block_index, const uncommitted_transaction_t &transaction) const;
 
+        /**
+         * Performs full validation of the transactions of a block
+         *
+         * Key image conflicts within the block are detected before the database is
+         * accessed and the key images of the block are then checked against the
+         * database as a single sorted batch rather than once per transaction
+         *
+         * @param block_index
+         * @param transactions
+         * @return
+         */
+        [[nodiscard]] Error validate(uint64_t block_index, const std::vector<transaction_t> &transactions) const;
+
+        /**
+         * Returns the verified cache used by the validator; the cache must be rewound
+         * whenever the blockchain is rewound
+         *
+         * @return
+         */
+        [[nodiscard]] std::shared_ptr<VerifiedCache> verified_cache() const;
+
       private:
+        /**
+         * Performs full validation of the transaction, optionally skipping the key image
+         * checks when they have already been performed for the block as a whole
+         *
+         * @param block_index
+         * @param transaction
+         * @param check_key_images
+         * @return
+         */
+        [[nodiscard]] Error
+            validate(uint64_t block_index, const transaction_t &transaction, bool check_key_images) const;
+
         std::shared_ptr<BlockchainStorage> m_blockchain_storage;
 
         std::shared_ptr<StakingEngine> m_staking_engine;
+
+        crypto_hash_t m_assume_valid_hash;
+
+        uint64_t m_assume_valid_index;
+
+        std::shared_ptr<VerifiedCache> m_verified_cache;
     };
 } // namespace Core
 
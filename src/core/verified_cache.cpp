@@ -0,0 +1,89 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "verified_cache.h"
+
+namespace Core
+{
+    VerifiedCache::VerifiedCache(size_t capacity): m_capacity(capacity == 0 ? 1 : capacity) {}
+
+    void VerifiedCache::add(const crypto_hash_t &txn_hash, uint64_t block_index)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        erase(txn_hash);
+
+        while (m_entries.size() >= m_capacity)
+        {
+            erase(m_by_age.begin()->second);
+        }
+
+        const auto sequence = m_sequence++;
+
+        m_entries.insert({txn_hash, {block_index, sequence}});
+
+        m_by_age.insert({sequence, txn_hash});
+
+        m_by_block.insert({block_index, txn_hash});
+    }
+
+    void VerifiedCache::clear()
+    {
+        std::scoped_lock lock(m_mutex);
+
+        m_entries.clear();
+
+        m_by_age.clear();
+
+        m_by_block.clear();
+    }
+
+    bool VerifiedCache::contains(const crypto_hash_t &txn_hash) const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_entries.find(txn_hash) != m_entries.end();
+    }
+
+    void VerifiedCache::erase(const crypto_hash_t &txn_hash)
+    {
+        if (m_entries.find(txn_hash) == m_entries.end())
+        {
+            return;
+        }
+
+        const auto [block_index, sequence] = m_entries.at(txn_hash);
+
+        m_by_age.erase(sequence);
+
+        m_by_block.erase({block_index, txn_hash});
+
+        m_entries.erase(txn_hash);
+    }
+
+    void VerifiedCache::remove(const crypto_hash_t &txn_hash)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        erase(txn_hash);
+    }
+
+    void VerifiedCache::rewind(uint64_t block_index)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        // the entries are ordered by block index, so we pop them off the back
+        while (!m_by_block.empty() && std::get<0>(*m_by_block.rbegin()) >= block_index)
+        {
+            erase(std::get<1>(*m_by_block.rbegin()));
+        }
+    }
+
+    size_t VerifiedCache::size() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_entries.size();
+    }
+} // namespace Core
@@ -0,0 +1,100 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef CORE_VERIFIED_CACHE_H
+#define CORE_VERIFIED_CACHE_H
+
+#include <config.h>
+#include <crypto_types.h>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace Core
+{
+    /**
+     * Remembers the transactions whose cryptographic checks (range proofs, ring
+     * signatures, and proof of work) have passed
+     *
+     * Entries are keyed by the transaction hash which commits to the ring members,
+     * signatures, and range proof of the transaction; as such the uncommitted and
+     * committed forms of a transaction resolve to the same entry. Each entry records
+     * the block index it was verified against so that the entries that may reference
+     * outputs removed by a rewind can be evicted. When full, the oldest entry is evicted.
+     */
+    class VerifiedCache
+    {
+      public:
+        VerifiedCache(size_t capacity = Configuration::Transaction::VERIFIED_CACHE_SIZE);
+
+        /**
+         * Records that the transaction passed its cryptographic checks when verified
+         * against the specified block index
+         *
+         * @param txn_hash
+         * @param block_index
+         */
+        void add(const crypto_hash_t &txn_hash, uint64_t block_index);
+
+        /**
+         * Removes all entries from the cache
+         */
+        void clear();
+
+        /**
+         * Returns whether the transaction has passed its cryptographic checks
+         *
+         * @param txn_hash
+         * @return
+         */
+        [[nodiscard]] bool contains(const crypto_hash_t &txn_hash) const;
+
+        /**
+         * Removes the transaction from the cache
+         *
+         * @param txn_hash
+         */
+        void remove(const crypto_hash_t &txn_hash);
+
+        /**
+         * Evicts the entries verified against the given block index or later; must be
+         * called whenever the chain is rewound to the given block index
+         *
+         * @param block_index
+         */
+        void rewind(uint64_t block_index);
+
+        /**
+         * Returns the number of entries in the cache
+         *
+         * @return
+         */
+        [[nodiscard]] size_t size() const;
+
+      private:
+        /**
+         * Removes the transaction from the cache; must be called while holding the mutex
+         *
+         * @param txn_hash
+         */
+        void erase(const crypto_hash_t &txn_hash);
+
+        size_t m_capacity;
+
+        uint64_t m_sequence = 0;
+
+        // txn_hash => [block_index, sequence]
+        std::map<crypto_hash_t, std::tuple<uint64_t, uint64_t>> m_entries;
+
+        // sequence => txn_hash, used to evict the oldest entry
+        std::map<uint64_t, crypto_hash_t> m_by_age;
+
+        // [block_index, txn_hash], used to evict entries on rewind
+        std::set<std::tuple<uint64_t, crypto_hash_t>> m_by_block;
+
+        mutable std::mutex m_mutex;
+    };
+} // namespace Core
+
+#endif // CORE_VERIFIED_CACHE_H
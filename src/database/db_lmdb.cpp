@@ -6,6 +6,7 @@
 
 #include <cppfs/FileHandle.h>
 #include <cppfs/fs.h>
+#include <cstring>
 #include <hashing.h>
 
 #define LMDB_SPACE_MULTIPLIER (1024 * 1024) // to MB
@@ -54,6 +55,23 @@ namespace Database
         return MAKE_ERROR(SUCCESS);
     }
 
+    bool LMDB::database_exists(const std::string &name)
+    {
+        if (!m_env)
+        {
+            return false;
+        }
+
+        auto env = instance(m_id);
+
+        auto txn = std::make_unique<LMDBTransaction>(env, true);
+
+        MDB_dbi dbi;
+
+        // without MDB_CREATE the database is only opened if it already exists
+        return mdb_dbi_open(*txn, name.c_str(), 0, &dbi) == MDB_SUCCESS;
+    }
+
     Error LMDB::detect_map_size() const
     {
         std::scoped_lock lock(m_mutex);
@@ -288,6 +306,168 @@ namespace Database
         return {MAKE_ERROR_MSG(result, MDB_STR_ERR(result)), readers};
     }
 
+    Error LMDB::migrate_database(const std::string &name, int flags)
+    {
+        // integer keys must be the size of a size_t (see LMDBDatabase::LMDBDatabase())
+        if (sizeof(size_t) != sizeof(uint64_t))
+        {
+            flags &= ~(MDB_INTEGERKEY | MDB_INTEGERDUP);
+        }
+
+        auto env = instance(m_id);
+
+        const auto temporary_name = name + "_migration";
+
+        /**
+         * Copies every key/value pair between the databases converting the 64-bit integer
+         * keys and/or values between their big-endian and native representations
+         */
+        const auto copy = [](MDB_txn *txn, MDB_dbi from, MDB_dbi to, int convert_keys, int convert_values, int flags)
+        {
+            const auto convert = [](const MDB_val &input, int direction, serializer_t &buffer)
+            {
+                if (direction == 0 || input.mv_size != sizeof(uint64_t))
+                {
+                    return input;
+                }
+
+                uint64_t integer;
+
+                buffer = serializer_t();
+
+                if (direction > 0)
+                {
+                    integer = deserializer_t(FROM_MDB_VAL(input)).uint64(false, true);
+
+                    buffer.bytes(&integer, sizeof(integer));
+                }
+                else
+                {
+                    std::memcpy(&integer, input.mv_data, sizeof(integer));
+
+                    buffer.uint64(integer, true);
+                }
+
+                return MDB_val {buffer.size(), (void *)buffer.data()};
+            };
+
+            MDB_cursor *cursor = nullptr;
+
+            auto result = mdb_cursor_open(txn, from, &cursor);
+
+            MDB_val key, value;
+
+            serializer_t key_buffer, value_buffer;
+
+            for (auto op = MDB_FIRST; result == MDB_SUCCESS; op = MDB_NEXT)
+            {
+                result = mdb_cursor_get(cursor, &key, &value, op);
+
+                if (result != MDB_SUCCESS)
+                {
+                    break;
+                }
+
+                auto i_key = convert(key, convert_keys, key_buffer);
+
+                auto i_value = convert(value, convert_values, value_buffer);
+
+                result = mdb_put(txn, to, &i_key, &i_value, flags);
+            }
+
+            if (cursor != nullptr)
+            {
+                mdb_cursor_close(cursor);
+            }
+
+            return (result == MDB_NOTFOUND) ? MDB_SUCCESS : result;
+        };
+
+    try_again:
+        auto txn = std::make_unique<LMDBTransaction>(env);
+
+        MDB_dbi source, temporary;
+
+        auto result = mdb_dbi_open(*txn, name.c_str(), 0, &source);
+
+        if (result == MDB_NOTFOUND)
+        {
+            return SUCCESS;
+        }
+
+        unsigned int source_flags = 0;
+
+        if (result == MDB_SUCCESS)
+        {
+            result = mdb_dbi_flags(*txn, source, &source_flags);
+        }
+
+        if (result != MDB_SUCCESS)
+        {
+            return MAKE_ERROR_MSG(result, MDB_STR_ERR(result));
+        }
+
+        // only the flags that are stored with the database need to match
+        const auto stored_flags = MDB_REVERSEKEY | MDB_DUPSORT | MDB_INTEGERKEY | MDB_DUPFIXED | MDB_INTEGERDUP;
+
+        if ((source_flags & stored_flags) == (flags & stored_flags))
+        {
+            return SUCCESS;
+        }
+
+        // +1 converts from big-endian to native integers, -1 converts from native to big-endian integers
+        const auto direction = [&](unsigned int flag)
+        { return ((flags & flag) ? 1 : 0) - ((source_flags & flag) ? 1 : 0); };
+
+        result = mdb_dbi_open(*txn, temporary_name.c_str(), MDB_CREATE | flags, &temporary);
+
+        if (result == MDB_SUCCESS)
+        {
+            result = mdb_drop(*txn, temporary, 0);
+        }
+
+        if (result == MDB_SUCCESS)
+        {
+            result = copy(*txn, source, temporary, direction(MDB_INTEGERKEY), direction(MDB_INTEGERDUP), 0);
+        }
+
+        if (result == MDB_SUCCESS)
+        {
+            result = mdb_drop(*txn, source, 1);
+        }
+
+        if (result == MDB_SUCCESS)
+        {
+            result = mdb_dbi_open(*txn, name.c_str(), MDB_CREATE | flags, &source);
+        }
+
+        // the keys are now in the order of the new database, so they can be appended
+        if (result == MDB_SUCCESS)
+        {
+            result = copy(*txn, temporary, source, 0, 0, MDB_APPEND | ((flags & MDB_DUPSORT) ? MDB_APPENDDUP : 0));
+        }
+
+        if (result == MDB_SUCCESS)
+        {
+            result = mdb_drop(*txn, temporary, 1);
+        }
+
+        auto error = MAKE_ERROR_MSG(result, MDB_STR_ERR(result));
+
+        MDB_CHECK_TXN_EXPAND(error, env, txn, try_again);
+
+        if (error)
+        {
+            return error;
+        }
+
+        error = txn->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, env, txn, try_again);
+
+        return error;
+    }
+
     std::shared_ptr<LMDBDatabase> LMDB::open_database(const std::string &name, int flags)
     {
         auto id = Crypto::Hashing::sha3(name.data(), name.size());
@@ -385,6 +565,12 @@ namespace Database
 
         const auto readonly = (env_flags & MDB_RDONLY);
 
+        // integer keys must be the size of a size_t so 64-bit keys are kept as big-endian bytes on 32-bit platforms
+        if (sizeof(size_t) != sizeof(uint64_t))
+        {
+            flags &= ~(MDB_INTEGERKEY | MDB_INTEGERDUP);
+        }
+
         auto txn = std::make_unique<LMDBTransaction>(m_env, readonly);
 
         auto success = mdb_dbi_open(*txn, name.empty() ? nullptr : name.c_str(), flags | MDB_CREATE, &m_dbi);
@@ -394,6 +580,13 @@ namespace Database
             throw std::runtime_error("Unable to open LMDB named database: " + MDB_STR_ERR(success));
         }
 
+        /**
+         * An existing database keeps the flags that it was created with regardless of the flags
+         * supplied here, so the keys are encoded according to the flags that it actually has
+         * (see LMDB::migrate_database())
+         */
+        mdb_dbi_flags(*txn, m_dbi, &m_flags);
+
         if (!(env_flags & MDB_RDONLY))
         {
             if (txn->commit() != SUCCESS)
@@ -433,6 +626,22 @@ namespace Database
         return count;
     }
 
+    uint64_t LMDBDatabase::decode_key(deserializer_t &reader) const
+    {
+        if (!(m_flags & MDB_INTEGERKEY))
+        {
+            return reader.uint64(false, true);
+        }
+
+        uint64_t key = 0;
+
+        const auto bytes = reader.bytes(sizeof(key));
+
+        std::memcpy(&key, bytes.data(), sizeof(key));
+
+        return key;
+    }
+
     Error LMDBDatabase::del(const serializer_t &key)
     {
     try_again:
@@ -456,9 +665,7 @@ namespace Database
 
     Error LMDBDatabase::del(const uint64_t &key)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = encode_key(key);
 
         return del(i_key);
     }
@@ -486,9 +693,7 @@ namespace Database
 
     Error LMDBDatabase::del(const uint64_t &key, const serializer_t &value)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = encode_key(key);
 
         return del(i_key, value);
     }
@@ -515,6 +720,22 @@ namespace Database
         return txn->commit();
     }
 
+    serializer_t LMDBDatabase::encode_key(const uint64_t &key) const
+    {
+        serializer_t writer;
+
+        if (m_flags & MDB_INTEGERKEY)
+        {
+            writer.bytes(&key, sizeof(key));
+        }
+        else
+        {
+            writer.uint64(key, true);
+        }
+
+        return writer;
+    }
+
     std::shared_ptr<LMDB> LMDBDatabase::env() const
     {
         return m_env;
@@ -529,13 +750,16 @@ namespace Database
 
     bool LMDBDatabase::exists(const uint64_t &key)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = encode_key(key);
 
         return exists(i_key);
     }
 
+    unsigned int LMDBDatabase::flags() const
+    {
+        return m_flags;
+    }
+
     std::tuple<Error, deserializer_t> LMDBDatabase::get(const serializer_t &key)
     {
         auto txn = transaction(true);
@@ -545,9 +769,7 @@ namespace Database
 
     std::tuple<Error, deserializer_t> LMDBDatabase::get(const uint64_t &key)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = encode_key(key);
 
         return get(i_key);
     }
@@ -556,18 +778,9 @@ namespace Database
     {
         std::vector<deserializer_t> results;
 
-        const auto keys = list_keys();
-
-        for (auto &key : keys)
+        for (auto &entry : iterate())
         {
-            serializer_t i_key(key.unread_data());
-
-            auto [error, value] = get(i_key);
-
-            if (!error)
-            {
-                results.push_back(value);
-            }
+            results.push_back(std::move(entry.value));
         }
 
         return results;
@@ -589,36 +802,24 @@ namespace Database
         return m_id;
     }
 
-    std::vector<deserializer_t> LMDBDatabase::list_keys(bool ignore_duplicates)
+    LMDBIterator LMDBDatabase::iterate(const lmdb_iterator_options_t &options)
     {
-        auto txn = transaction(true);
-
-        auto cursor = txn->cursor();
+        return LMDBIterator(transaction(true), options);
+    }
 
+    std::vector<deserializer_t> LMDBDatabase::list_keys(bool ignore_duplicates)
+    {
         std::vector<deserializer_t> results;
 
-        MDB_val key, value;
+        lmdb_iterator_options_t options;
 
-        size_t count = 0;
+        options.ignore_duplicates = ignore_duplicates;
 
-        deserializer_t last_key({});
+        options.keys_only = true;
 
-        while (mdb_cursor_get(*cursor, &key, &value, count ? MDB_NEXT : MDB_FIRST) == MDB_SUCCESS)
+        for (auto &entry : iterate(options))
         {
-            auto data = FROM_MDB_VAL(key);
-
-            deserializer_t r_key(data);
-
-            if (ignore_duplicates && r_key.to_string() == last_key.to_string())
-            {
-                continue;
-            }
-
-            results.push_back(r_key);
-
-            last_key = r_key;
-
-            count++;
+            results.push_back(std::move(entry.key));
         }
 
         return results;
@@ -649,9 +850,7 @@ namespace Database
 
     Error LMDBDatabase::put(const uint64_t &key, const serializer_t &value, int flags)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = encode_key(key);
 
         return put(i_key, value, flags);
     }
@@ -706,6 +905,26 @@ namespace Database
         m_txn = nullptr;
     }
 
+    Error LMDBTransaction::append(const serializer_t &key, const serializer_t &value)
+    {
+        const auto flags = MDB_APPEND | ((m_db->flags() & MDB_DUPSORT) ? MDB_APPENDDUP : 0);
+
+        auto error = put(key, value, flags);
+
+        // the key is not greater than the last key in the database
+        if (error == LMDB_KEYEXIST)
+        {
+            error = put(key, value);
+        }
+
+        return error;
+    }
+
+    Error LMDBTransaction::append(const uint64_t &key, const serializer_t &value)
+    {
+        return append(m_db->encode_key(key), value);
+    }
+
     Error LMDBTransaction::commit()
     {
         if (!m_txn)
@@ -754,18 +973,14 @@ namespace Database
 
     Error LMDBTransaction::del(const uint64_t &key)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         return del(i_key);
     }
 
     Error LMDBTransaction::del(const uint64_t &key, const serializer_t &value)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         return del(i_key, value);
     }
@@ -783,9 +998,7 @@ namespace Database
 
     bool LMDBTransaction::exists(const uint64_t &key)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         return exists(i_key);
     }
@@ -812,9 +1025,7 @@ namespace Database
 
     std::tuple<Error, deserializer_t> LMDBTransaction::get(const uint64_t &key)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         return get(i_key);
     }
@@ -844,9 +1055,7 @@ namespace Database
 
     Error LMDBTransaction::put(const uint64_t &key, const serializer_t &value, int flags)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         return put(i_key, value, flags);
     }
@@ -880,7 +1089,7 @@ namespace Database
         return MAKE_ERROR_MSG(result, MDB_STR_ERR(result));
     }
 
-    void LMDBTransaction::set_database(std::shared_ptr<LMDBDatabase> &db)
+    void LMDBTransaction::set_database(const std::shared_ptr<LMDBDatabase> &db)
     {
         m_db = db;
     }
@@ -1025,9 +1234,7 @@ namespace Database
 
     std::tuple<Error, uint64_t, deserializer_t> LMDBCursor::get(const uint64_t &key, const MDB_cursor_op &op)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         auto [error, r_key, r_value] = get(i_key, op);
 
@@ -1036,7 +1243,7 @@ namespace Database
             return {error, {}, {}};
         }
 
-        return {error, r_key.uint64(false, true), r_value};
+        return {error, m_db->decode_key(r_key), r_value};
     }
 
     std::tuple<Error, deserializer_t, std::vector<deserializer_t>> LMDBCursor::get_all(const serializer_t &key)
@@ -1064,9 +1271,7 @@ namespace Database
 
     std::tuple<Error, uint64_t, std::vector<deserializer_t>> LMDBCursor::get_all(const uint64_t &key)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         auto [error, r_key, r_value] = get_all(i_key);
 
@@ -1075,7 +1280,7 @@ namespace Database
             return {error, {}, {}};
         }
 
-        return {error, r_key.uint64(false, true), r_value};
+        return {error, m_db->decode_key(r_key), r_value};
     }
 
     Error LMDBCursor::put(const serializer_t &key, const serializer_t &value, int flags)
@@ -1091,9 +1296,7 @@ namespace Database
 
     Error LMDBCursor::put(const uint64_t &key, const serializer_t &value, int flags)
     {
-        serializer_t i_key;
-
-        i_key.uint64(key, true);
+        const auto i_key = m_db->encode_key(key);
 
         return put(i_key, value, flags);
     }
@@ -1109,4 +1312,140 @@ namespace Database
 
         return MAKE_ERROR_MSG(result, MDB_STR_ERR(result));
     }
+
+    LMDBIterator::iterator_t::iterator_t(LMDBIterator *parent): m_parent(parent) {}
+
+    LMDBIterator::entry_t &LMDBIterator::iterator_t::operator*() const
+    {
+        return m_parent->m_entry;
+    }
+
+    LMDBIterator::entry_t *LMDBIterator::iterator_t::operator->() const
+    {
+        return &m_parent->m_entry;
+    }
+
+    LMDBIterator::iterator_t &LMDBIterator::iterator_t::operator++()
+    {
+        m_parent->advance();
+
+        return *this;
+    }
+
+    bool LMDBIterator::iterator_t::operator==(const iterator_t &other) const
+    {
+        // every position of a single-pass iterator is equal except the end
+        const auto done = !m_parent || m_parent->m_done;
+
+        const auto other_done = !other.m_parent || other.m_parent->m_done;
+
+        return done == other_done;
+    }
+
+    bool LMDBIterator::iterator_t::operator!=(const iterator_t &other) const
+    {
+        return !(*this == other);
+    }
+
+    LMDBIterator::LMDBIterator(std::unique_ptr<LMDBTransaction> txn, lmdb_iterator_options_t options):
+        m_options(std::move(options)), m_txn(std::move(txn))
+    {
+        m_cursor = m_txn->cursor();
+    }
+
+    LMDBIterator::LMDBIterator(LMDBIterator &&other) noexcept = default;
+
+    LMDBIterator::~LMDBIterator()
+    {
+        m_cursor.reset();
+
+        m_txn.reset();
+    }
+
+    void LMDBIterator::advance()
+    {
+        if (m_done)
+        {
+            return;
+        }
+
+        MDB_val key, value;
+
+        while (m_options.limit == 0 || m_count < m_options.limit)
+        {
+            int result;
+
+            if (!m_started && !m_options.start_key.empty())
+            {
+                key = {m_options.start_key.size(), m_options.start_key.data()};
+
+                result = mdb_cursor_get(*m_cursor, &key, &value, MDB_SET_RANGE);
+            }
+            else if (!m_started)
+            {
+                result = mdb_cursor_get(*m_cursor, &key, &value, MDB_FIRST);
+            }
+            else
+            {
+                const auto op = m_options.ignore_duplicates ? MDB_NEXT_NODUP : MDB_NEXT;
+
+                result = mdb_cursor_get(*m_cursor, &key, &value, op);
+            }
+
+            m_started = true;
+
+            if (result != MDB_SUCCESS)
+            {
+                break;
+            }
+
+            if (!m_options.end_key.empty())
+            {
+                MDB_val end = {m_options.end_key.size(), m_options.end_key.data()};
+
+                if (mdb_cmp(*m_txn, mdb_cursor_dbi(*m_cursor), &key, &end) >= 0)
+                {
+                    break;
+                }
+            }
+
+            // the key/value pair is only copied out of the database if the predicate accepts it
+            if (m_options.predicate && !m_options.predicate(key, value))
+            {
+                continue;
+            }
+
+            m_entry.key = deserializer_t(FROM_MDB_VAL(key));
+
+            m_entry.value = m_options.keys_only ? deserializer_t({}) : deserializer_t(FROM_MDB_VAL(value));
+
+            m_count++;
+
+            return;
+        }
+
+        m_started = true;
+
+        m_done = true;
+    }
+
+    LMDBIterator::iterator_t LMDBIterator::begin()
+    {
+        if (!m_started)
+        {
+            advance();
+        }
+
+        return iterator_t(this);
+    }
+
+    size_t LMDBIterator::count() const
+    {
+        return m_count;
+    }
+
+    LMDBIterator::iterator_t LMDBIterator::end()
+    {
+        return iterator_t();
+    }
 } // namespace Database
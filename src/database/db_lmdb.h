@@ -7,6 +7,8 @@
 
 #include <crypto_types.h>
 #include <errors.h>
+#include <functional>
+#include <iterator>
 #include <lmdb.h>
 #include <map>
 #include <memory>
@@ -41,6 +43,7 @@ namespace Database
     class LMDBDatabase;
     class LMDBTransaction;
     class LMDBCursor;
+    class LMDBIterator;
 
     /**
      * Wraps the LMDB C API into an OOP model that allows for opening and using
@@ -58,6 +61,14 @@ namespace Database
          */
         Error close();
 
+        /**
+         * Checks whether the named database exists in the environment without creating it
+         *
+         * @param name
+         * @return
+         */
+        bool database_exists(const std::string &name);
+
         /**
          * Detects the current memory map size if it has been changed elsewhere
          * This requires that there are no open R/W transactions; otherwise, the method
@@ -168,6 +179,25 @@ namespace Database
          */
         std::tuple<Error, unsigned int> max_readers() const;
 
+        /**
+         * Rebuilds an existing database with the specified flags, for example to switch a
+         * database that is keyed by 64-bit integers to MDB_INTEGERKEY. Keys (and values
+         * for MDB_INTEGERDUP) previously stored as big-endian 64-bit integers are converted
+         * to native integers. A database that does not exist, or already has the flags,
+         * is left as is.
+         *
+         * The database is copied into a temporary database, recreated with the new flags,
+         * and copied back in a single transaction so that an interrupted migration leaves
+         * the database untouched.
+         *
+         * NOTE: must be called before the database is opened via open_database()
+         *
+         * @param name
+         * @param flags
+         * @return
+         */
+        Error migrate_database(const std::string &name, int flags);
+
         /**
          * Opens a database (separate key space) in the environment as a logical
          * partitioning of data.
@@ -255,6 +285,138 @@ namespace Database
         size_t m_open_txns;
     };
 
+    /**
+     * The range and filtering of a database iteration (see LMDBIterator)
+     */
+    struct lmdb_iterator_options_t
+    {
+        // the first key to return (inclusive), empty starts at the first key in the database
+        std::vector<uint8_t> start_key;
+
+        // the key to stop at (exclusive), empty continues to the last key in the database
+        std::vector<uint8_t> end_key;
+
+        // when set, only the first value of a key that has duplicate values is returned
+        bool ignore_duplicates = true;
+
+        // when set, the values are not copied out of the database
+        bool keys_only = false;
+
+        // the maximum number of key/value pairs returned, zero is unlimited
+        size_t limit = 0;
+
+        /**
+         * Called with each key/value pair in the range before it is copied out of the
+         * database, pairs for which it returns false are skipped and do not count
+         * towards the limit
+         */
+        std::function<bool(const MDB_val &key, const MDB_val &value)> predicate;
+    };
+
+    /**
+     * Iterates the key/value pairs of a database in key order with a single cursor
+     * opened in a single read-only transaction. The iterator is compatible with a
+     * range-based for loop and is single-pass.
+     *
+     * The transaction is held open until the iterator is destroyed, as the environment
+     * cannot be expanded while transactions are open, iterators should be short-lived
+     * and must not be held while writing to the environment from the same thread.
+     */
+    class LMDBIterator
+    {
+      public:
+        struct entry_t
+        {
+            deserializer_t key = deserializer_t({});
+
+            deserializer_t value = deserializer_t({});
+        };
+
+        class iterator_t
+        {
+          public:
+            using iterator_category = std::input_iterator_tag;
+
+            using value_type = entry_t;
+
+            using difference_type = std::ptrdiff_t;
+
+            using pointer = entry_t *;
+
+            using reference = entry_t &;
+
+            explicit iterator_t(LMDBIterator *parent = nullptr);
+
+            reference operator*() const;
+
+            pointer operator->() const;
+
+            iterator_t &operator++();
+
+            bool operator==(const iterator_t &other) const;
+
+            bool operator!=(const iterator_t &other) const;
+
+          private:
+            LMDBIterator *m_parent;
+        };
+
+        /**
+         * Creates a new iterator over the database of the transaction
+         *
+         * DO NOT CALL THIS METHOD DIRECTLY!
+         *
+         * @param txn
+         * @param options
+         */
+        LMDBIterator(std::unique_ptr<LMDBTransaction> txn, lmdb_iterator_options_t options);
+
+        LMDBIterator(LMDBIterator &&other) noexcept;
+
+        ~LMDBIterator();
+
+        /**
+         * Positions the cursor at the first key/value pair in the range, as the iterator
+         * is single-pass, subsequent calls return the current position
+         *
+         * @return
+         */
+        iterator_t begin();
+
+        /**
+         * Returns the number of key/value pairs returned thus far
+         *
+         * @return
+         */
+        [[nodiscard]] size_t count() const;
+
+        /**
+         * Returns the position past the last key/value pair in the range
+         *
+         * @return
+         */
+        iterator_t end();
+
+      private:
+        /**
+         * Moves the cursor to the next key/value pair in the range that matches the predicate
+         */
+        void advance();
+
+        lmdb_iterator_options_t m_options;
+
+        // the cursor must be closed before the transaction
+        std::unique_ptr<LMDBTransaction> m_txn;
+
+        std::unique_ptr<LMDBCursor> m_cursor;
+
+        entry_t m_entry;
+
+        size_t m_count = 0;
+
+        bool m_started = false, m_done = false;
+    };
+
     /**
      * Provides a Database model for use within an LMDB environment
      */
@@ -283,6 +445,14 @@ namespace Database
          */
         size_t count();
 
+        /**
+         * Decodes a 64-bit integer key as stored in the database (see encode_key())
+         *
+         * @param reader
+         * @return
+         */
+        uint64_t decode_key(deserializer_t &reader) const;
+
         /**
          * Simplified deletion of the given key and its value. Automatically opens a
          * transaction, deletes the key, and commits the transaction, then returns.
@@ -410,6 +580,16 @@ namespace Database
          */
         Error drop(bool delete_db);
 
+        /**
+         * Encodes a 64-bit integer key for the database. Databases opened with MDB_INTEGERKEY
+         * store the native integer, all others store the big-endian integer so that the keys
+         * still sort in numeric order.
+         *
+         * @param key
+         * @return
+         */
+        serializer_t encode_key(const uint64_t &key) const;
+
         /**
          * Returns the current LMDB environment associated with this database
          *
@@ -449,6 +629,13 @@ namespace Database
          */
         bool exists(const uint64_t &key);
 
+        /**
+         * Returns the flags of the database as they were when it was opened
+         *
+         * @return
+         */
+        [[nodiscard]] unsigned int flags() const;
+
         /**
          * Simplified retrieval of the value at the specified key which opens a new
          * readonly transaction, retrieves the value, and then returns it as the
@@ -550,18 +737,20 @@ namespace Database
         }
 
         /**
-         * Simplifies retrieval of all values for all keys in the database
+         * Simplifies retrieval of all values for all keys in the database, only the first
+         * value of a key with duplicate values is returned
          *
-         * WARNING: Very likely slow with large key sets
+         * WARNING: Holds every value in memory, use iterate() for large key sets
          *
          * @return
          */
         std::vector<deserializer_t> get_all();
 
         /**
-         * Simplifies retrieval of all values for all keys in the database
+         * Simplifies retrieval of all values for all keys in the database, only the first
+         * value of a key with duplicate values is returned
          *
-         * WARNING: Very likely slow with large key sets
+         * WARNING: Holds every value in memory, use iterate() for large key sets
          *
          * @tparam Value
          * @return
@@ -570,13 +759,11 @@ namespace Database
         {
             std::vector<Value> results;
 
-            auto all = get_all();
-
-            for (auto &reader : all)
+            for (auto &entry : iterate())
             {
                 Value value;
 
-                value.deserialize(reader);
+                value.deserialize(entry.value);
 
                 results.push_back(value);
             }
@@ -598,6 +785,15 @@ namespace Database
          */
         crypto_hash_t id() const;
 
+        /**
+         * Iterates the key/value pairs in the database, or the range of it specified in
+         * the options, from a single read-only transaction (see LMDBIterator)
+         *
+         * @param options
+         * @return
+         */
+        LMDBIterator iterate(const lmdb_iterator_options_t &options = lmdb_iterator_options_t());
+
         /**
          * Lists all keys in the database
          *
@@ -617,13 +813,17 @@ namespace Database
         {
             std::vector<Key> results;
 
-            auto all = list_keys(ignore_duplicates);
+            lmdb_iterator_options_t options;
+
+            options.ignore_duplicates = ignore_duplicates;
+
+            options.keys_only = true;
 
-            for (auto &reader : all)
+            for (auto &entry : iterate(options))
             {
                 Key key;
 
-                key.deserialize(reader);
+                key.deserialize(entry.key);
 
                 results.push_back(key);
             }
@@ -735,6 +935,8 @@ namespace Database
 
         MDB_dbi m_dbi;
 
+        unsigned int m_flags = 0;
+
         mutable std::mutex m_db_mutex;
     };
 
@@ -780,6 +982,65 @@ namespace Database
          */
         void abort();
 
+        /**
+         * Puts the specified value with the specified key in the database, as the key is expected
+         * to be greater than (or for MDB_DUPSORT databases, equal to) the last key in the database
+         * it is appended with MDB_APPEND (or MDB_APPENDDUP) which skips the search of the B-tree
+         * and fills pages instead of splitting them. Keys that are not in order fall back to
+         * a regular put.
+         *
+         * Note: You must check for MDB_MAP_FULL or MDB_TXN_FULL response values and handle those
+         * yourself as you will very likely need to abort the current transaction and expand
+         * the LMDB environment before re-attempting the transaction.
+         *
+         * @param key
+         * @param value
+         * @return
+         */
+        Error append(const serializer_t &key, const serializer_t &value);
+
+        /**
+         * Puts the specified value with the specified key in the database, as the key is expected
+         * to be greater than (or for MDB_DUPSORT databases, equal to) the last key in the database
+         * it is appended with MDB_APPEND (or MDB_APPENDDUP) which skips the search of the B-tree
+         * and fills pages instead of splitting them. Keys that are not in order fall back to
+         * a regular put.
+         *
+         * Note: You must check for MDB_MAP_FULL or MDB_TXN_FULL response values and handle those
+         * yourself as you will very likely need to abort the current transaction and expand
+         * the LMDB environment before re-attempting the transaction.
+         *
+         * @param key
+         * @param value
+         * @return
+         */
+        Error append(const uint64_t &key, const serializer_t &value);
+
+        /**
+         * Puts the specified value with the specified key in the database, as the key is expected
+         * to be greater than (or for MDB_DUPSORT databases, equal to) the last key in the database
+         * it is appended with MDB_APPEND (or MDB_APPENDDUP) which skips the search of the B-tree
+         * and fills pages instead of splitting them. Keys that are not in order fall back to
+         * a regular put.
+         *
+         * Note: You must check for MDB_MAP_FULL or MDB_TXN_FULL response values and handle those
+         * yourself as you will very likely need to abort the current transaction and expand
+         * the LMDB environment before re-attempting the transaction.
+         *
+         * @tparam Value
+         * @param key
+         * @param value
+         * @return
+         */
+        template<typename Value> Error append(const uint64_t &key, const Value &value)
+        {
+            serializer_t i_value;
+
+            value.serialize(i_value);
+
+            return append(key, i_value);
+        }
+
         /**
          * Commits the currently open transaction
          *
@@ -1147,7 +1408,7 @@ namespace Database
          *
          * @param db
          */
-        void set_database(std::shared_ptr<LMDBDatabase> &db);
+        void set_database(const std::shared_ptr<LMDBDatabase> &db);
 
       private:
         /**
@@ -50,6 +50,8 @@ std::string Error::to_string() const
             return "The operation completed successfully.";
         case DB_EMPTY:
             return "The database is empty";
+        case DB_NOT_EMPTY:
+            return "The database is not empty";
         case BASE58_DECODE:
             return "Could not decode Base58 string.";
         case ADDRESS_PREFIX_MISMATCH:
@@ -64,6 +66,24 @@ std::string Error::to_string() const
             return "The transaction type encountered is of an unknown type and cannot be handled.";
         case BLOCK_TXN_ORDER:
             return "The transactions supplied for the DB are not in the same order as specified in the block.";
+        case BLOCK_NOT_PENDING:
+            return "The block is not awaiting validator signatures.";
+        case BLOCK_VALIDATOR_NOT_ELECTED:
+            return "The public key is not an elected validator for the block.";
+        case BLOCK_INVALID_VALIDATOR_SIGNATURE:
+            return "The validator signature for the block is invalid.";
+        case BLOCK_DECODE:
+            return "The block and its transactions could not be decoded.";
+        case BLOCK_INVALID_CONSTRUCTION:
+            return "The block is not properly constructed or signed.";
+        case BLOCK_NOT_NEXT:
+            return "The block does not extend the current top of the chain.";
+        case BLOCK_ASSUME_VALID_MISMATCH:
+            return "The block does not match the assume valid checkpoint.";
+        case BLOCK_TEMPLATE_NOT_PREPARED:
+            return "The block template has not been prepared for the block index.";
+        case TX_KEY_IMAGE_PENDING:
+            return "A key image of the transaction is already used by another pending transaction.";
         case STAKING_CANDIDATE_NOT_FOUND:
             return "The staking candidate was not found in the database.";
         case STAKING_STAKER_NOT_FOUND:
@@ -42,10 +42,19 @@ enum ErrorCode
     DB_BLOCK_NOT_FOUND,
     DB_TRANSACTION_NOT_FOUND,
     DB_TRANSACTION_OUTPUT_NOT_FOUND,
+    DB_NOT_EMPTY,
 
     // block error code(s)
     BLOCK_TXN_ORDER,
     BLOCK_TXN_MISMATCH,
+    BLOCK_NOT_PENDING,
+    BLOCK_VALIDATOR_NOT_ELECTED,
+    BLOCK_INVALID_VALIDATOR_SIGNATURE,
+    BLOCK_DECODE,
+    BLOCK_INVALID_CONSTRUCTION,
+    BLOCK_NOT_NEXT,
+    BLOCK_ASSUME_VALID_MISMATCH,
+    BLOCK_TEMPLATE_NOT_PREPARED,
 
     // transaction error code(s)
     UNKNOWN_TRANSACTION_TYPE,
@@ -86,6 +95,7 @@ enum ErrorCode
     TX_INVALID_RING_SIGNATURE,
     TX_GENESIS_ALREADY_EXISTS,
     TX_STAKING_PUBLIC_KEYS_REUSE,
+    TX_KEY_IMAGE_PENDING,
 
     // staking error code(s)
     STAKING_CANDIDATE_ALREADY_EXISTS,
@@ -19,6 +19,9 @@ namespace Networking
      * HTTP and HTTPS (TLS) client in the same method calls. Also provides
      * a number of helper methods for parsing result bodies.
      *
+     * Callers that make repeated requests to the same host should lease clients
+     * from an HTTPClientPool instead so that connections are reused.
+     *
      */
     class HTTPClient
     {
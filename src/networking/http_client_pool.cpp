@@ -0,0 +1,210 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "http_client_pool.h"
+
+#include <atomic>
+#include <map>
+#include <thread>
+
+static std::map<std::string, std::shared_ptr<Networking::HTTPClientPool>> instances;
+
+static std::mutex instances_mutex;
+
+namespace Networking
+{
+    HTTPClientPool::lease_t::lease_t(HTTPClientPool *pool, std::shared_ptr<httplib::Client> client):
+        m_pool(pool), m_client(std::move(client))
+    {
+    }
+
+    HTTPClientPool::lease_t::lease_t(lease_t &&other) noexcept:
+        m_pool(other.m_pool), m_client(std::move(other.m_client))
+    {
+        other.m_pool = nullptr;
+    }
+
+    HTTPClientPool::lease_t::~lease_t()
+    {
+        if (m_pool && m_client)
+        {
+            m_pool->release(std::move(m_client));
+        }
+    }
+
+    httplib::Client *HTTPClientPool::lease_t::operator->() const
+    {
+        return m_client.get();
+    }
+
+    httplib::Client &HTTPClientPool::lease_t::operator*() const
+    {
+        return *m_client;
+    }
+
+    HTTPClientPool::HTTPClientPool(
+        std::string host,
+        uint16_t port,
+        bool ssl,
+        size_t maximum_connections,
+        size_t idle_timeout,
+        int timeout):
+        m_host(std::move(host)),
+        m_port(port),
+        m_ssl(ssl),
+        m_maximum_connections(std::max<size_t>(maximum_connections, 1)),
+        m_idle_timeout(idle_timeout),
+        m_timeout(timeout)
+    {
+    }
+
+    HTTPClientPool::lease_t HTTPClientPool::acquire()
+    {
+        std::unique_lock lock(m_mutex);
+
+        evict_idle_locked();
+
+        m_returned.wait(lock, [this] { return !m_idle.empty() || m_active < m_maximum_connections; });
+
+        m_active++;
+
+        if (!m_idle.empty())
+        {
+            auto client = std::move(m_idle.back().client);
+
+            m_idle.pop_back();
+
+            return lease_t(this, std::move(client));
+        }
+
+        // the connection itself is established by the first request made with the client
+        lock.unlock();
+
+        return lease_t(this, HTTPClient::create_client(m_host, m_port, true, m_ssl, m_timeout));
+    }
+
+    size_t HTTPClientPool::active() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_active;
+    }
+
+    void HTTPClientPool::batch(const std::vector<std::function<void(httplib::Client &)>> &requests)
+    {
+        std::atomic<size_t> next = 0;
+
+        const auto runner = [&]()
+        {
+            auto client = acquire();
+
+            for (auto i = next++; i < requests.size(); i = next++)
+            {
+                requests[i](*client);
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        // the calling thread runs requests too so a single request does not start a thread
+        const auto count = std::min(requests.size(), m_maximum_connections);
+
+        for (size_t i = 1; i < count; ++i)
+        {
+            threads.emplace_back(runner);
+        }
+
+        if (count != 0)
+        {
+            runner();
+        }
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void HTTPClientPool::evict_idle()
+    {
+        std::scoped_lock lock(m_mutex);
+
+        evict_idle_locked();
+    }
+
+    void HTTPClientPool::evict_idle_locked()
+    {
+        const auto cutoff = std::chrono::steady_clock::now() - m_idle_timeout;
+
+        // the clients are ordered by the time they were returned so the stale ones are at the front
+        auto it = m_idle.begin();
+
+        while (it != m_idle.end() && it->last_used < cutoff)
+        {
+            ++it;
+        }
+
+        m_idle.erase(m_idle.begin(), it);
+    }
+
+    std::vector<std::shared_ptr<httplib::Response>>
+        HTTPClientPool::get(const std::vector<std::string> &paths, const httplib::Headers &headers)
+    {
+        std::vector<std::shared_ptr<httplib::Response>> responses(paths.size());
+
+        std::vector<std::function<void(httplib::Client &)>> requests;
+
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            requests.emplace_back(
+                [&, i](httplib::Client &client)
+                {
+                    auto result = client.Get(paths[i].c_str(), headers);
+
+                    if (result)
+                    {
+                        responses[i] = std::make_shared<httplib::Response>(result.value());
+                    }
+                });
+        }
+
+        batch(requests);
+
+        return responses;
+    }
+
+    size_t HTTPClientPool::idle() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_idle.size();
+    }
+
+    std::shared_ptr<HTTPClientPool> HTTPClientPool::instance(const std::string &host, uint16_t port, bool ssl)
+    {
+        const auto origin = std::string(ssl ? "https://" : "http://") + host + ":" + std::to_string(port);
+
+        std::scoped_lock lock(instances_mutex);
+
+        if (instances.find(origin) == instances.end())
+        {
+            instances.insert({origin, std::make_shared<HTTPClientPool>(host, port, ssl)});
+        }
+
+        return instances.at(origin);
+    }
+
+    void HTTPClientPool::release(std::shared_ptr<httplib::Client> client)
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+
+            m_active--;
+
+            m_idle.push_back({std::move(client), std::chrono::steady_clock::now()});
+        }
+
+        m_returned.notify_one();
+    }
+} // namespace Networking
@@ -0,0 +1,180 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_NETWORKING_HTTP_CLIENT_POOL_H
+#define TURTLECOIN_NETWORKING_HTTP_CLIENT_POOL_H
+
+#include "http_client.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace Networking
+{
+    /**
+     * A pool of keep-alive HTTP/s clients connected to a single origin so that repeated
+     * requests to the same host reuse established connections instead of paying for
+     * the TCP (and TLS) handshake every time
+     *
+     * A client is leased from the pool for the duration of one or more requests and is
+     * returned to the pool, with its connection still open, when the lease is destroyed.
+     * At most the configured number of clients are leased at once; further requests
+     * wait for a client to be returned. Clients that sit idle for longer than the idle
+     * timeout are closed.
+     *
+     * The pools are shared per origin via instance(); a pool may also be constructed
+     * directly in which case its leases must not outlive it.
+     */
+    class HTTPClientPool
+    {
+      public:
+        /**
+         * Exclusive use of a pooled client, the client is returned to the pool on destruction
+         */
+        class lease_t
+        {
+          public:
+            lease_t(HTTPClientPool *pool, std::shared_ptr<httplib::Client> client);
+
+            lease_t(lease_t &&other) noexcept;
+
+            lease_t(const lease_t &) = delete;
+
+            ~lease_t();
+
+            lease_t &operator=(const lease_t &) = delete;
+
+            httplib::Client *operator->() const;
+
+            httplib::Client &operator*() const;
+
+          private:
+            HTTPClientPool *m_pool;
+
+            std::shared_ptr<httplib::Client> m_client;
+        };
+
+        /**
+         * Creates a new pool of clients for the specified origin
+         *
+         * @param host
+         * @param port
+         * @param ssl
+         * @param maximum_connections
+         * @param idle_timeout in seconds
+         * @param timeout the connection timeout in milliseconds
+         */
+        HTTPClientPool(
+            std::string host,
+            uint16_t port,
+            bool ssl = false,
+            size_t maximum_connections = Configuration::API::HTTP_CLIENT_MAXIMUM_CONNECTIONS,
+            size_t idle_timeout = Configuration::API::HTTP_CLIENT_IDLE_TIMEOUT,
+            int timeout = Configuration::DEFAULT_CONNECTION_TIMEOUT);
+
+        /**
+         * Leases a client from the pool, waiting for one to be returned if the maximum
+         * number of clients are already leased
+         *
+         * @return
+         */
+        lease_t acquire();
+
+        /**
+         * Returns the number of clients currently leased
+         *
+         * @return
+         */
+        [[nodiscard]] size_t active() const;
+
+        /**
+         * Runs each of the requests on a pooled client, using up to the maximum number of
+         * connections of the pool in parallel, and returns once all of them have completed
+         *
+         * NOTE: must not be called while holding a lease from the same pool
+         *
+         * @param requests
+         */
+        void batch(const std::vector<std::function<void(httplib::Client &)>> &requests);
+
+        /**
+         * Closes the idle clients that have not been used within the idle timeout
+         */
+        void evict_idle();
+
+        /**
+         * Performs a GET request for each of the paths in parallel (see batch())
+         *
+         * @param paths
+         * @param headers
+         * @return the responses in the same order as the paths, failed requests return nullptr
+         */
+        std::vector<std::shared_ptr<httplib::Response>>
+            get(const std::vector<std::string> &paths, const httplib::Headers &headers = {});
+
+        /**
+         * Returns the number of idle clients held open for reuse
+         *
+         * @return
+         */
+        [[nodiscard]] size_t idle() const;
+
+        /**
+         * Returns the pool shared by all callers for the specified origin, the pool is
+         * created with the default limits the first time that it is requested
+         *
+         * @param host
+         * @param port
+         * @param ssl
+         * @return
+         */
+        static std::shared_ptr<HTTPClientPool> instance(const std::string &host, uint16_t port, bool ssl = false);
+
+      private:
+        struct idle_client_t
+        {
+            std::shared_ptr<httplib::Client> client;
+
+            std::chrono::steady_clock::time_point last_used;
+        };
+
+        /**
+         * Closes the idle clients that have not been used within the idle timeout
+         *
+         * NOTE: the mutex must be held by the caller
+         */
+        void evict_idle_locked();
+
+        /**
+         * Returns the client to the pool
+         *
+         * @param client
+         */
+        void release(std::shared_ptr<httplib::Client> client);
+
+        std::string m_host;
+
+        uint16_t m_port;
+
+        bool m_ssl;
+
+        size_t m_maximum_connections;
+
+        std::chrono::seconds m_idle_timeout;
+
+        int m_timeout;
+
+        size_t m_active = 0;
+
+        // the most recently returned client is at the back and is reused first
+        std::vector<idle_client_t> m_idle;
+
+        mutable std::mutex m_mutex;
+
+        std::condition_variable m_returned;
+    };
+} // namespace Networking
+
+#endif
@@ -0,0 +1,318 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "http_compression.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <sstream>
+
+#ifdef HTTP_COMPRESSION
+#include <zlib.h>
+#endif
+
+#define COMPRESSION_BUFFER_SIZE 16'384
+
+static inline std::string trim(const std::string &value)
+{
+    const auto start = value.find_first_not_of(" \t");
+
+    if (start == std::string::npos)
+    {
+        return std::string();
+    }
+
+    const auto end = value.find_last_not_of(" \t");
+
+    return value.substr(start, end - start + 1);
+}
+
+static inline bool compressible(const std::string &content_type)
+{
+    // binary content (e.g. keys and hashes) does not compress enough to be worth the effort
+    return content_type.rfind("text/", 0) == 0 || content_type.find("json") != std::string::npos
+           || content_type.find("javascript") != std::string::npos
+           || content_type.find("xml") != std::string::npos;
+}
+
+namespace Networking
+{
+    struct HTTPCompressor::stream_t
+    {
+#ifdef HTTP_COMPRESSION
+        z_stream zs {};
+
+        bool initialized = false;
+#endif
+    };
+
+    HTTPCompressor::HTTPCompressor(HTTPContentEncoding encoding, int level): m_stream(std::make_unique<stream_t>())
+    {
+#ifdef HTTP_COMPRESSION
+        // a window of 15 bits produces the zlib format (deflate) and adding 16 produces the gzip format
+        const auto window_bits = (encoding == HTTP_ENCODING_GZIP) ? 15 + 16 : 15;
+
+        m_stream->initialized =
+            deflateInit2(&m_stream->zs, std::clamp(level, 1, 9), Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY)
+            == Z_OK;
+#endif
+    }
+
+    HTTPCompressor::~HTTPCompressor()
+    {
+#ifdef HTTP_COMPRESSION
+        if (m_stream->initialized)
+        {
+            deflateEnd(&m_stream->zs);
+        }
+#endif
+    }
+
+    bool HTTPCompressor::compress(const char *data, size_t length, bool finish, std::string &output)
+    {
+#ifdef HTTP_COMPRESSION
+        if (!m_stream->initialized)
+        {
+            return false;
+        }
+
+        auto &zs = m_stream->zs;
+
+        zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+
+        zs.avail_in = static_cast<uInt>(length);
+
+        char buffer[COMPRESSION_BUFFER_SIZE];
+
+        // each chunk is flushed so that a streaming client receives data as it is produced
+        do
+        {
+            zs.next_out = reinterpret_cast<Bytef *>(buffer);
+
+            zs.avail_out = sizeof(buffer);
+
+            if (deflate(&zs, finish ? Z_FINISH : Z_SYNC_FLUSH) == Z_STREAM_ERROR)
+            {
+                return false;
+            }
+
+            output.append(buffer, sizeof(buffer) - zs.avail_out);
+        } while (zs.avail_out == 0);
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void HTTPCompressor::compress_response(
+        const httplib::Request &request,
+        httplib::Response &response,
+        int level,
+        size_t threshold)
+    {
+        if (level <= 0 || response.has_header("Content-Encoding") || request.method == "HEAD")
+        {
+            return;
+        }
+
+        const auto streamed = static_cast<bool>(response.content_provider_);
+
+        if (!streamed && response.body.size() < std::max<size_t>(threshold, 1))
+        {
+            return;
+        }
+
+        if (!compressible(response.get_header_value("Content-Type")))
+        {
+            return;
+        }
+
+        const auto encoding = negotiate(request.get_header_value("Accept-Encoding"));
+
+        // the response differs by the encoding that the client accepts whether or not we compress it
+        response.set_header("Vary", "Accept-Encoding");
+
+        if (encoding == HTTP_ENCODING_IDENTITY)
+        {
+            return;
+        }
+
+        auto compressor = std::make_shared<HTTPCompressor>(encoding, level);
+
+        if (!streamed)
+        {
+            std::string body;
+
+            if (!compressor->compress(response.body.data(), response.body.size(), true, body))
+            {
+                return;
+            }
+
+            response.body = std::move(body);
+        }
+        else
+        {
+            /**
+             * The original provider is handed the offsets of the uncompressed content while
+             * the compressed content is written to the client. A provider with a known length
+             * is converted into a chunked provider as the compressed length is not known up front.
+             */
+            const auto provider = response.content_provider_;
+
+            const auto content_length = response.is_chunked_content_provider_ ? 0 : response.content_length_;
+
+            auto offset = std::make_shared<size_t>(0);
+
+            response.content_provider_ =
+                [compressor, provider, content_length, offset](size_t, size_t, httplib::DataSink &sink)
+            {
+                bool ok = true, finished = false;
+
+                const auto finish = [&]()
+                {
+                    std::string tail;
+
+                    finished = true;
+
+                    ok = compressor->compress(nullptr, 0, true, tail)
+                         && (tail.empty() || sink.write(tail.data(), tail.size()));
+
+                    sink.done();
+                };
+
+                httplib::DataSink inner;
+
+                inner.write = [&](const char *data, size_t length)
+                {
+                    std::string chunk;
+
+                    *offset += length;
+
+                    if (!compressor->compress(data, length, false, chunk))
+                    {
+                        return ok = false;
+                    }
+
+                    return chunk.empty() || sink.write(chunk.data(), chunk.size());
+                };
+
+                inner.done = finish;
+
+                inner.is_writable = sink.is_writable;
+
+                if (!provider(*offset, content_length - std::min(content_length, *offset), inner))
+                {
+                    return false;
+                }
+
+                // a provider with a known length does not call done once the content is complete
+                if (!finished && content_length != 0 && *offset >= content_length)
+                {
+                    finish();
+                }
+
+                return ok;
+            };
+
+            response.content_length_ = 0;
+
+            response.is_chunked_content_provider_ = true;
+        }
+
+        // the ETag identifies the bytes of the response, so each encoding of the same content needs its own tag
+        if (response.has_header("ETag"))
+        {
+            auto etag = response.get_header_value("ETag");
+
+            if (etag.size() >= 2 && etag.back() == '"')
+            {
+                etag.insert(etag.size() - 1, "-" + encoding_name(encoding));
+
+                response.headers.erase("ETag");
+
+                response.set_header("ETag", etag);
+            }
+        }
+
+        response.set_header("Content-Encoding", encoding_name(encoding));
+    }
+
+    std::string HTTPCompressor::encoding_name(HTTPContentEncoding encoding)
+    {
+        switch (encoding)
+        {
+            case HTTP_ENCODING_GZIP:
+                return "gzip";
+            case HTTP_ENCODING_DEFLATE:
+                return "deflate";
+            default:
+                return "identity";
+        }
+    }
+
+    HTTPContentEncoding HTTPCompressor::negotiate(const std::string &accept_encoding)
+    {
+#ifdef HTTP_COMPRESSION
+        // the codings that the client lists take precedence over the wildcard, which covers the rest
+        std::optional<bool> gzip_accepted, deflate_accepted, any_accepted;
+
+        std::stringstream stream(accept_encoding);
+
+        std::string item;
+
+        while (std::getline(stream, item, ','))
+        {
+            auto name = item, quality = std::string("1");
+
+            const auto separator = item.find(';');
+
+            if (separator != std::string::npos)
+            {
+                name = item.substr(0, separator);
+
+                const auto parameter = trim(item.substr(separator + 1));
+
+                if (parameter.rfind("q=", 0) == 0)
+                {
+                    quality = parameter.substr(2);
+                }
+            }
+
+            name = trim(name);
+
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+            // a quality of zero means that the client refuses the encoding
+            const auto accepted = std::strtod(quality.c_str(), nullptr) > 0;
+
+            if (name == "gzip" || name == "x-gzip")
+            {
+                gzip_accepted = accepted;
+            }
+            else if (name == "deflate")
+            {
+                deflate_accepted = accepted;
+            }
+            else if (name == "*")
+            {
+                any_accepted = accepted;
+            }
+        }
+
+        if (gzip_accepted.value_or(any_accepted.value_or(false)))
+        {
+            return HTTP_ENCODING_GZIP;
+        }
+
+        if (deflate_accepted.value_or(any_accepted.value_or(false)))
+        {
+            return HTTP_ENCODING_DEFLATE;
+        }
+#endif
+
+        return HTTP_ENCODING_IDENTITY;
+    }
+} // namespace Networking
@@ -0,0 +1,101 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_NETWORKING_HTTP_COMPRESSION_H
+#define TURTLECOIN_NETWORKING_HTTP_COMPRESSION_H
+
+#include <httplib.h>
+#include <memory>
+#include <string>
+
+namespace Networking
+{
+    enum HTTPContentEncoding
+    {
+        HTTP_ENCODING_IDENTITY,
+        HTTP_ENCODING_GZIP,
+        HTTP_ENCODING_DEFLATE
+    };
+
+    /**
+     * Compresses HTTP response bodies in the content encoding negotiated with the client
+     *
+     * Compression is only available when the build found zlib (HTTP_COMPRESSION), otherwise
+     * every request negotiates the identity encoding and responses are sent as is.
+     */
+    class HTTPCompressor
+    {
+      public:
+        /**
+         * Creates a streaming compressor for the specified encoding
+         *
+         * @param encoding
+         * @param level the zlib compression level (1-9)
+         */
+        HTTPCompressor(HTTPContentEncoding encoding, int level);
+
+        ~HTTPCompressor();
+
+        HTTPCompressor(const HTTPCompressor &) = delete;
+
+        HTTPCompressor &operator=(const HTTPCompressor &) = delete;
+
+        /**
+         * Compresses the data and appends the output that is ready to the supplied string,
+         * the last call must set finish so that the end of the stream is written
+         *
+         * @param data
+         * @param length
+         * @param finish
+         * @param output
+         * @return whether the data was compressed
+         */
+        bool compress(const char *data, size_t length, bool finish, std::string &output);
+
+        /**
+         * Compresses the response body, or wraps its content provider so that the content
+         * is compressed as it is streamed, if the client accepts a supported encoding, the
+         * content type is compressible, and the body is at least the threshold in size
+         * (bodies streamed by a content provider are always compressed)
+         *
+         * A strong ETag of a compressed response is suffixed with the encoding (e.g. "tag-gzip")
+         * as the bytes of each encoding differ
+         *
+         * @param request
+         * @param response
+         * @param level the zlib compression level (1-9), zero disables compression
+         * @param threshold the minimum size of a body to compress in bytes
+         */
+        static void compress_response(
+            const httplib::Request &request,
+            httplib::Response &response,
+            int level,
+            size_t threshold);
+
+        /**
+         * Returns the name of the encoding as used in the Content-Encoding header
+         *
+         * @param encoding
+         * @return
+         */
+        static std::string encoding_name(HTTPContentEncoding encoding);
+
+        /**
+         * Selects the preferred supported encoding from the value of an Accept-Encoding header
+         *
+         * The wildcard (*) only applies to the encodings that the header does not list
+         *
+         * @param accept_encoding
+         * @return
+         */
+        static HTTPContentEncoding negotiate(const std::string &accept_encoding);
+
+      private:
+        struct stream_t;
+
+        std::unique_ptr<stream_t> m_stream;
+    };
+} // namespace Networking
+
+#endif
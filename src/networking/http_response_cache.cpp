@@ -0,0 +1,236 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "http_response_cache.h"
+
+#include <config.h>
+#include <hashing.h>
+#include <sstream>
+#include <utilities.h>
+
+static inline std::string cache_key(const std::string &resource, const std::string &encoding)
+{
+    return encoding + ":" + resource;
+}
+
+/**
+ * Returns the tag listed in the If-None-Match header that matches the ETag, or any of the tags
+ * that the compressed encodings of the response carry (see HTTPCompressor), if there is one
+ */
+static inline std::string matching_etag(const std::string &if_none_match, const std::string &etag)
+{
+    // the tag without its closing quote prefixes the tags of every encoding of the response
+    const auto prefix = etag.substr(0, etag.size() - 1) + "-";
+
+    std::stringstream stream(if_none_match);
+
+    std::string tag;
+
+    while (std::getline(stream, tag, ','))
+    {
+        Utilities::str_trim(tag);
+
+        if (tag == "*")
+        {
+            return etag;
+        }
+
+        // If-None-Match uses the weak comparison
+        if (tag.rfind("W/", 0) == 0)
+        {
+            tag = tag.substr(2);
+        }
+
+        if (tag == etag || (tag.rfind(prefix, 0) == 0 && tag.size() > prefix.size() && tag.back() == '"'))
+        {
+            return tag;
+        }
+    }
+
+    return std::string();
+}
+
+namespace Networking
+{
+    HTTPResponseCache::HTTPResponseCache(size_t maximum_bytes): m_maximum_bytes(maximum_bytes) {}
+
+    size_t HTTPResponseCache::bytes() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_bytes;
+    }
+
+    void HTTPResponseCache::clear()
+    {
+        std::scoped_lock lock(m_mutex);
+
+        m_entries.clear();
+
+        m_recently_used.clear();
+
+        m_bytes = 0;
+    }
+
+    size_t HTTPResponseCache::count() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_entries.size();
+    }
+
+    void HTTPResponseCache::erase(std::unordered_map<std::string, entry_t>::iterator it)
+    {
+        m_bytes -= it->second.body.size();
+
+        m_recently_used.erase(it->second.position);
+
+        m_entries.erase(it);
+    }
+
+    bool HTTPResponseCache::get(
+        const httplib::Request &request,
+        httplib::Response &response,
+        const std::string &resource,
+        const std::string &encoding)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        const auto it = m_entries.find(cache_key(resource, encoding));
+
+        if (it == m_entries.end())
+        {
+            m_misses++;
+
+            return false;
+        }
+
+        m_hits++;
+
+        // move the entry to the front of the least recently used list
+        m_recently_used.splice(m_recently_used.begin(), m_recently_used, it->second.position);
+
+        serve(request, response, it->second);
+
+        return true;
+    }
+
+    size_t HTTPResponseCache::hits() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_hits;
+    }
+
+    size_t HTTPResponseCache::misses() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_misses;
+    }
+
+    void HTTPResponseCache::put(
+        const httplib::Request &request,
+        httplib::Response &response,
+        const std::string &resource,
+        const std::string &encoding,
+        uint64_t block_index,
+        std::string body,
+        const std::string &content_type)
+    {
+        entry_t entry;
+
+        // a strong validator as the body is identical byte for byte for the same ETag
+        entry.etag = "\"" + Crypto::Hashing::sha3(body.data(), body.size()).to_string() + "\"";
+
+        entry.body = std::move(body);
+
+        entry.content_type = content_type;
+
+        entry.block_index = block_index;
+
+        serve(request, response, entry);
+
+        // a body that would evict everything else is served but not kept
+        if (entry.body.size() > m_maximum_bytes / 2)
+        {
+            return;
+        }
+
+        const auto key = cache_key(resource, encoding);
+
+        std::scoped_lock lock(m_mutex);
+
+        // another request may have stored the same resource while we were encoding it
+        {
+            const auto it = m_entries.find(key);
+
+            if (it != m_entries.end())
+            {
+                erase(it);
+            }
+        }
+
+        while (!m_recently_used.empty() && m_bytes + entry.body.size() > m_maximum_bytes)
+        {
+            erase(m_entries.find(m_recently_used.back()));
+        }
+
+        m_recently_used.push_front(key);
+
+        entry.position = m_recently_used.begin();
+
+        m_bytes += entry.body.size();
+
+        m_entries.emplace(key, std::move(entry));
+    }
+
+    void HTTPResponseCache::rewind(uint64_t block_index)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (it->second.block_index > block_index)
+            {
+                const auto next = std::next(it);
+
+                erase(it);
+
+                it = next;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void HTTPResponseCache::serve(const httplib::Request &request, httplib::Response &response, const entry_t &entry)
+    {
+        response.set_header(
+            "Cache-Control",
+            "public, max-age=" + std::to_string(Configuration::API::HTTP_IMMUTABLE_MAX_AGE) + ", immutable");
+
+        if (request.has_header("If-None-Match"))
+        {
+            // the header may hold a list of ETags or a wildcard
+            const auto etag = matching_etag(request.get_header_value("If-None-Match"), entry.etag);
+
+            // the client holds the encoding of the response that the tag it presented belongs to
+            if (!etag.empty())
+            {
+                response.set_header("ETag", etag);
+
+                response.status = 304;
+
+                return;
+            }
+        }
+
+        response.set_header("ETag", entry.etag);
+
+        response.set_content(entry.body, entry.content_type);
+    }
+} // namespace Networking
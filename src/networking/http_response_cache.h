@@ -0,0 +1,158 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_NETWORKING_HTTP_RESPONSE_CACHE_H
+#define TURTLECOIN_NETWORKING_HTTP_RESPONSE_CACHE_H
+
+#include <httplib.h>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace Networking
+{
+    /**
+     * Caches the fully encoded responses of resources that never change once the chain
+     * has moved past them (e.g. blocks and transactions below the top of the chain) so
+     * that popular resources are not read from the database and encoded again for every
+     * request
+     *
+     * Entries are keyed by the resource (e.g. a block hash or height) and the encoding of
+     * the response, and record the block index that the resource belongs to so that the
+     * entries above a rewind height may be dropped. Responses served from (or stored in)
+     * the cache carry a strong ETag and are marked as immutable; a request that presents
+     * the ETag, or the ETag of a compressed encoding of the response, via If-None-Match
+     * receives a 304 without a body.
+     *
+     * The cache holds at most the configured number of bytes of response bodies and
+     * evicts the least recently used entries first.
+     */
+    class HTTPResponseCache
+    {
+      public:
+        /**
+         * Creates a new cache that holds up to the specified number of bytes of response bodies
+         *
+         * @param maximum_bytes
+         */
+        HTTPResponseCache(size_t maximum_bytes);
+
+        /**
+         * Returns the number of bytes of response bodies currently held
+         *
+         * @return
+         */
+        [[nodiscard]] size_t bytes() const;
+
+        /**
+         * Drops all entries from the cache
+         */
+        void clear();
+
+        /**
+         * Returns the number of entries currently held
+         *
+         * @return
+         */
+        [[nodiscard]] size_t count() const;
+
+        /**
+         * Serves the response from the cache if the resource is cached in the specified encoding
+         *
+         * @param request
+         * @param response
+         * @param resource
+         * @param encoding
+         * @return whether the response was served
+         */
+        bool get(
+            const httplib::Request &request,
+            httplib::Response &response,
+            const std::string &resource,
+            const std::string &encoding);
+
+        /**
+         * Returns the number of requests that were served from the cache
+         *
+         * @return
+         */
+        [[nodiscard]] size_t hits() const;
+
+        /**
+         * Returns the number of requests that were not served from the cache
+         *
+         * @return
+         */
+        [[nodiscard]] size_t misses() const;
+
+        /**
+         * Stores the encoded response of the resource in the cache and serves it
+         *
+         * @param request
+         * @param response
+         * @param resource
+         * @param encoding
+         * @param block_index the block that the resource belongs to
+         * @param body
+         * @param content_type
+         */
+        void put(
+            const httplib::Request &request,
+            httplib::Response &response,
+            const std::string &resource,
+            const std::string &encoding,
+            uint64_t block_index,
+            std::string body,
+            const std::string &content_type);
+
+        /**
+         * Drops the entries of the resources that belong to blocks above the specified block index
+         *
+         * NOTE: must be called whenever the blockchain is rewound
+         *
+         * @param block_index
+         */
+        void rewind(uint64_t block_index);
+
+      private:
+        struct entry_t
+        {
+            std::string body, content_type, etag;
+
+            uint64_t block_index = 0;
+
+            // the position of the entry in the least recently used list
+            std::list<std::string>::iterator position;
+        };
+
+        /**
+         * Removes the entry from the cache
+         *
+         * NOTE: the mutex must be held by the caller
+         *
+         * @param it
+         */
+        void erase(std::unordered_map<std::string, entry_t>::iterator it);
+
+        /**
+         * Builds the response from the entry, or a 304 if the client already holds it
+         *
+         * @param request
+         * @param response
+         * @param entry
+         */
+        static void serve(const httplib::Request &request, httplib::Response &response, const entry_t &entry);
+
+        size_t m_maximum_bytes, m_bytes = 0, m_hits = 0, m_misses = 0;
+
+        std::unordered_map<std::string, entry_t> m_entries;
+
+        // the keys of the entries with the most recently used at the front
+        std::list<std::string> m_recently_used;
+
+        mutable std::mutex m_mutex;
+    };
+} // namespace Networking
+
+#endif
@@ -6,39 +6,56 @@
 
 namespace Networking
 {
-    HTTPServer::HTTPServer(logger &logger, std::string cors_domain):
-        m_cors_domain(std::move(cors_domain)), m_port(0), m_logger(logger), m_host("")
+    HTTPServer::HTTPServer(logger &logger, std::string cors_domain, const http_server_options_t &options):
+        m_cors_domain(std::move(cors_domain)),
+        m_port(0),
+        m_logger(logger),
+        m_host(""),
+        m_response_cache(std::make_shared<HTTPResponseCache>(options.response_cache_size)),
+        m_options(options)
     {
-        // auto set security headers
-        set_post_routing_handler(
-            [this](const auto &req, auto &res)
-            {
-                res.set_header("Access-Control-Allow-Origin", m_cors_domain);
-
-                res.set_header("X-Requested-With", "*");
-
-                res.set_header(
-                    "Access-Control-Allow-Headers", "Origin, X-Requested-With, Content-Type, Accept, User-Agent");
+        set_keep_alive_max_count(m_options.keep_alive_max_count);
 
-                res.set_header("Access-Control-Allow-Methods", "GET, DELETE, HEAD, POST, PUT, PATCH, OPTIONS");
+        set_keep_alive_timeout(m_options.keep_alive_timeout);
 
-                res.set_header("Referrer-Policy", "no-referrer");
+        set_read_timeout(m_options.read_timeout, 0);
 
-                res.set_header("Content-Security-Policy", "default-src 'none'");
+        set_write_timeout(m_options.write_timeout, 0);
 
-                res.set_header(
-                    "Feature-Policy",
-                    "geolocation none;midi none;notifications none;push none;sync-xhr none;microphone none;camera "
-                    "none;magnetometer none;gyroscope none;speaker self;vibrate none;fullscreen self;payment none;");
-
-                res.set_header(
-                    "Permissions-Policy",
-                    "geolocation=(), midi=(), notifications=(), push=(), sync-xhr=(), microphone=(), camera=(), "
-                    "magnetometer=(), gyroscope=(), speaker=(self), vibrate=(), fullscreen=(self), payment=()");
-
-                res.set_header("X-Frame-Options", "SAMEORIGIN");
+        new_task_queue = [this]()
+        {
+            const auto threads = (m_options.worker_threads != 0)
+                                     ? m_options.worker_threads
+                                     : std::max<size_t>(std::thread::hardware_concurrency(), 8);
+
+            return new HTTPWorkerPool(threads, m_options.maximum_queued_connections, m_rejected_connections);
+        };
+
+        // the security headers are the same for every response so they are only built once
+        m_static_headers = {
+            {"Access-Control-Allow-Origin", m_cors_domain},
+            {"X-Requested-With", "*"},
+            {"Access-Control-Allow-Headers", "Origin, X-Requested-With, Content-Type, Accept, User-Agent"},
+            {"Access-Control-Allow-Methods", "GET, DELETE, HEAD, POST, PUT, PATCH, OPTIONS"},
+            {"Referrer-Policy", "no-referrer"},
+            {"Content-Security-Policy", "default-src 'none'"},
+            {"Feature-Policy",
+             "geolocation none;midi none;notifications none;push none;sync-xhr none;microphone none;camera "
+             "none;magnetometer none;gyroscope none;speaker self;vibrate none;fullscreen self;payment none;"},
+            {"Permissions-Policy",
+             "geolocation=(), midi=(), notifications=(), push=(), sync-xhr=(), microphone=(), camera=(), "
+             "magnetometer=(), gyroscope=(), speaker=(self), vibrate=(), fullscreen=(self), payment=()"},
+            {"X-Frame-Options", "SAMEORIGIN"},
+            {"X-Content-Type-Options", "nosniff"}};
+
+        // auto set security headers and compress the response if the client accepts it
+        set_post_routing_handler(
+            [this](const auto &req, auto &res)
+            {
+                res.headers.insert(m_static_headers.begin(), m_static_headers.end());
 
-                res.set_header("X-Content-Type-Options", "nosniff");
+                HTTPCompressor::compress_response(
+                    req, res, m_options.compression_level, m_options.compression_threshold);
             });
 
         set_exception_handler(
@@ -59,6 +76,40 @@ namespace Networking
         shutdown();
     }
 
+    void HTTPServer::add_options(Utilities::CLIHelper &cli, http_server_options_t &options)
+    {
+        // clang-format off
+        cli.add_options("HTTP Server")
+            ("http-workers", "The number of threads that process HTTP connections (0 = automatic)",
+             cxxopts::value<size_t>(options.worker_threads)
+                ->default_value(std::to_string(options.worker_threads)), "#")
+            ("http-queue", "The number of HTTP connections that may wait for a worker before receiving a 503",
+             cxxopts::value<size_t>(options.maximum_queued_connections)
+                ->default_value(std::to_string(options.maximum_queued_connections)), "#")
+            ("http-keep-alive-max", "The maximum number of requests served over a keep-alive HTTP connection",
+             cxxopts::value<size_t>(options.keep_alive_max_count)
+                ->default_value(std::to_string(options.keep_alive_max_count)), "#")
+            ("http-keep-alive-timeout", "The number of seconds that an idle keep-alive HTTP connection is held open",
+             cxxopts::value<size_t>(options.keep_alive_timeout)
+                ->default_value(std::to_string(options.keep_alive_timeout)), "#")
+            ("http-read-timeout", "The number of seconds allowed to read an HTTP request",
+             cxxopts::value<size_t>(options.read_timeout)
+                ->default_value(std::to_string(options.read_timeout)), "#")
+            ("http-write-timeout", "The number of seconds allowed to write an HTTP response",
+             cxxopts::value<size_t>(options.write_timeout)
+                ->default_value(std::to_string(options.write_timeout)), "#")
+            ("http-cache-size", "The number of bytes of HTTP responses cached for chain data that no longer changes",
+             cxxopts::value<size_t>(options.response_cache_size)
+                ->default_value(std::to_string(options.response_cache_size)), "#")
+            ("http-compression-level", "The zlib level (1-9) used to compress HTTP responses (0 = disabled)",
+             cxxopts::value<int>(options.compression_level)
+                ->default_value(std::to_string(options.compression_level)), "#")
+            ("http-compression-threshold", "The minimum number of bytes of an HTTP response body to compress",
+             cxxopts::value<size_t>(options.compression_threshold)
+                ->default_value(std::to_string(options.compression_threshold)), "#");
+        // clang-format on
+    }
+
     std::string HTTPServer::cors_domain() const
     {
         return m_cors_domain;
@@ -100,6 +151,11 @@ namespace Networking
         return true;
     }
 
+    const http_server_options_t &HTTPServer::options() const
+    {
+        return m_options;
+    }
+
     std::tuple<Error, rapidjson::Document>
         HTTPServer::parse_json_body(const httplib::Request &request, const HTTPBodyMode &body_mode)
     {
@@ -158,6 +214,54 @@ namespace Networking
         return m_port;
     }
 
+    bool HTTPServer::process_and_close_socket(socket_t sock)
+    {
+        bool result = false;
+
+        if (HTTPWorkerPool::rejecting())
+        {
+            // the response is small enough to fit in the send buffer, so this does not wait on the client
+            static const std::string rejection = "HTTP/1.1 503 Service Unavailable\r\n"
+                                                 "Retry-After: 1\r\n"
+                                                 "Connection: close\r\n"
+                                                 "Content-Length: 0\r\n\r\n";
+
+            httplib::detail::SocketStream stream(
+                sock, read_timeout_sec_, read_timeout_usec_, write_timeout_sec_, write_timeout_usec_);
+
+            result = stream.write(rejection.data(), rejection.size()) == static_cast<ssize_t>(rejection.size());
+        }
+        else if (!HTTPWorkerPool::closing())
+        {
+            result = httplib::detail::process_server_socket(
+                sock,
+                keep_alive_max_count_,
+                keep_alive_timeout_sec_,
+                read_timeout_sec_,
+                read_timeout_usec_,
+                write_timeout_sec_,
+                write_timeout_usec_,
+                [this](httplib::Stream &stream, bool close_connection, bool &connection_closed)
+                { return process_request(stream, close_connection, connection_closed, nullptr); });
+        }
+
+        httplib::detail::shutdown_socket(sock);
+
+        httplib::detail::close_socket(sock);
+
+        return result;
+    }
+
+    size_t HTTPServer::rejected_connections() const
+    {
+        return m_rejected_connections;
+    }
+
+    std::shared_ptr<HTTPResponseCache> HTTPServer::response_cache() const
+    {
+        return m_response_cache;
+    }
+
     void HTTPServer::server_listener()
     {
         if (!listen_after_bind())
@@ -5,15 +5,46 @@
 #ifndef TURTLECOIN_NETWORKING_HTTP_SERVER_H
 #define TURTLECOIN_NETWORKING_HTTP_SERVER_H
 
+#include "http_compression.h"
+#include "http_response_cache.h"
 #include "http_shared.h"
+#include "http_worker_pool.h"
 #include "upnp.h"
 
+#include <cli_helper.h>
+#include <config.h>
 #include <errors.h>
 #include <httplib.h>
 #include <logger.h>
 
 namespace Networking
 {
+    /**
+     * The connection handling and caching parameters of the HTTP server, the timeouts are in seconds
+     */
+    struct http_server_options_t
+    {
+        // zero uses one thread per hardware thread (with a minimum of eight)
+        size_t worker_threads = Configuration::API::HTTP_WORKER_THREADS;
+
+        size_t maximum_queued_connections = Configuration::API::HTTP_MAXIMUM_QUEUED_CONNECTIONS;
+
+        size_t keep_alive_max_count = Configuration::API::HTTP_KEEP_ALIVE_MAX_COUNT;
+
+        size_t keep_alive_timeout = Configuration::API::HTTP_KEEP_ALIVE_TIMEOUT;
+
+        size_t read_timeout = Configuration::API::HTTP_READ_TIMEOUT;
+
+        size_t write_timeout = Configuration::API::HTTP_WRITE_TIMEOUT;
+
+        size_t response_cache_size = Configuration::API::HTTP_RESPONSE_CACHE_SIZE;
+
+        // zero disables the compression of responses
+        int compression_level = Configuration::API::HTTP_COMPRESSION_LEVEL;
+
+        size_t compression_threshold = Configuration::API::HTTP_COMPRESSION_THRESHOLD;
+    };
+
     /**
      * Implements a simple HTTP server that automatically configures a number of
      * security based headers that are useful for RESTful API interfaces. It also
@@ -22,6 +53,16 @@ namespace Networking
      * from the server instance (ie. throwing error messages back to the client
      * from the stack that *may* potentially contain sensitive information).
      *
+     * Handlers of resources that no longer change may keep their encoded responses
+     * in the response cache of the server (see HTTPResponseCache).
+     *
+     * Connections are processed by a fixed pool of worker threads with a bounded
+     * queue; connections that arrive while the queue is full receive a 503 (see
+     * HTTPWorkerPool). Keep-alive connections serve their requests, including those
+     * pipelined by the client, in order until the keep-alive limits are reached.
+     *
+     * Responses are compressed for clients that accept it (see HTTPCompressor).
+     *
      */
     class HTTPServer : public httplib::Server
     {
@@ -31,14 +72,27 @@ namespace Networking
          *
          * @param logger the shared logger
          * @param cors_domain
+         * @param options
          */
-        HTTPServer(logger &logger, std::string cors_domain = "*");
+        HTTPServer(
+            logger &logger,
+            std::string cors_domain = "*",
+            const http_server_options_t &options = http_server_options_t());
 
         /**
          * Destroys the instance
          */
         ~HTTPServer();
 
+        /**
+         * Adds the HTTP server options to the command line options, the values are
+         * loaded into the supplied structure when the command line is parsed
+         *
+         * @param cli
+         * @param options
+         */
+        static void add_options(Utilities::CLIHelper &cli, http_server_options_t &options);
+
         /**
          * Returns the CORS domain that the server is providing in requests
          *
@@ -66,6 +120,13 @@ namespace Networking
          */
         bool listen(const std::string &host, int port, int socket_flags = 0);
 
+        /**
+         * Returns the options that the server was created with
+         *
+         * @return
+         */
+        const http_server_options_t &options() const;
+
         /**
          * Parses the request body and returns the json document if it can be parsed
          *
@@ -93,6 +154,20 @@ namespace Networking
          */
         uint16_t port() const;
 
+        /**
+         * Returns the number of connections that were turned away because the queue was full
+         *
+         * @return
+         */
+        size_t rejected_connections() const;
+
+        /**
+         * Returns the cache of encoded responses for resources that no longer change
+         *
+         * @return
+         */
+        std::shared_ptr<HTTPResponseCache> response_cache() const;
+
         /**
          * Shuts down the server and stops the thread that it is contained within
          */
@@ -106,6 +181,18 @@ namespace Networking
         bool upnp_active() const;
 
       private:
+        /**
+         * Processes the connection accepted by the server and closes it; connections that the
+         * worker pool turned away receive a 503 without their request being read, or are closed
+         * without a response if even the rejection queue is full
+         *
+         * NOTE: mirrors httplib::Server::process_and_close_socket for the connections that are processed
+         *
+         * @param sock
+         * @return
+         */
+        bool process_and_close_socket(socket_t sock) override;
+
         void server_listener();
 
         std::string m_cors_domain;
@@ -116,6 +203,15 @@ namespace Networking
 
         std::unique_ptr<UPNP> m_upnp_helper;
 
+        std::shared_ptr<HTTPResponseCache> m_response_cache;
+
+        http_server_options_t m_options;
+
+        // the headers that are added to every response, built once
+        httplib::Headers m_static_headers;
+
+        std::atomic<size_t> m_rejected_connections = 0;
+
         std::thread m_server_thread;
 
         logger m_logger;
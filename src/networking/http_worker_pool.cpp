@@ -0,0 +1,162 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "http_worker_pool.h"
+
+static thread_local bool t_rejecting = false, t_closing = false;
+
+namespace Networking
+{
+    HTTPWorkerPool::HTTPWorkerPool(
+        size_t threads,
+        size_t maximum_queued,
+        std::atomic<size_t> &rejected,
+        size_t maximum_rejections):
+        m_maximum_queued(maximum_queued), m_maximum_rejections(maximum_rejections), m_rejected(rejected)
+    {
+        for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+        {
+            m_workers.emplace_back(&HTTPWorkerPool::worker, this);
+        }
+
+        m_rejector = std::thread(&HTTPWorkerPool::rejector, this);
+    }
+
+    HTTPWorkerPool::~HTTPWorkerPool()
+    {
+        shutdown();
+    }
+
+    bool HTTPWorkerPool::closing()
+    {
+        return t_closing;
+    }
+
+    void HTTPWorkerPool::enqueue(std::function<void()> fn)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+
+            if (m_queue.size() < m_maximum_queued)
+            {
+                m_queue.push_back(std::move(fn));
+
+                lock.unlock();
+
+                m_queue_cv.notify_one();
+
+                return;
+            }
+
+            m_rejected++;
+
+            if (m_rejections.size() < m_maximum_rejections)
+            {
+                m_rejections.push_back(std::move(fn));
+
+                lock.unlock();
+
+                m_rejections_cv.notify_one();
+
+                return;
+            }
+        }
+
+        // closing the socket is all the task does in this mode, so it is cheap enough to run on the accepting thread
+        t_closing = true;
+
+        fn();
+
+        t_closing = false;
+    }
+
+    bool HTTPWorkerPool::rejecting()
+    {
+        return t_rejecting;
+    }
+
+    void HTTPWorkerPool::rejector()
+    {
+        t_rejecting = true;
+
+        while (true)
+        {
+            std::function<void()> fn;
+
+            {
+                std::unique_lock lock(m_mutex);
+
+                m_rejections_cv.wait(lock, [this] { return m_shutdown || !m_rejections.empty(); });
+
+                if (m_rejections.empty())
+                {
+                    break;
+                }
+
+                fn = std::move(m_rejections.front());
+
+                m_rejections.pop_front();
+            }
+
+            fn();
+        }
+    }
+
+    void HTTPWorkerPool::shutdown()
+    {
+        {
+            std::unique_lock lock(m_mutex);
+
+            if (m_shutdown)
+            {
+                return;
+            }
+
+            m_shutdown = true;
+        }
+
+        m_queue_cv.notify_all();
+
+        m_rejections_cv.notify_all();
+
+        // the threads drain their queues before they exit so that every socket is closed
+        for (auto &thread : m_workers)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+
+        if (m_rejector.joinable())
+        {
+            m_rejector.join();
+        }
+    }
+
+    void HTTPWorkerPool::worker()
+    {
+        while (true)
+        {
+            std::function<void()> fn;
+
+            {
+                std::unique_lock lock(m_mutex);
+
+                m_queue_cv.wait(lock, [this] { return m_shutdown || !m_queue.empty(); });
+
+                if (m_queue.empty())
+                {
+                    break;
+                }
+
+                fn = std::move(m_queue.front());
+
+                m_queue.pop_front();
+            }
+
+            fn();
+        }
+    }
+} // namespace Networking
@@ -0,0 +1,104 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_NETWORKING_HTTP_WORKER_POOL_H
+#define TURTLECOIN_NETWORKING_HTTP_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <config.h>
+#include <deque>
+#include <httplib.h>
+#include <mutex>
+#include <thread>
+
+namespace Networking
+{
+    /**
+     * The task queue that processes the connections accepted by the HTTP server
+     *
+     * Connections are processed by a fixed number of worker threads and at most the
+     * configured number of connections may wait for a worker. Connections that arrive
+     * while the queue is full cannot simply be dropped as the task also closes the
+     * socket; instead they are handed to a single rejection thread that answers them
+     * with a 503 without reading the request (see rejecting()). The rejection queue is
+     * bounded as well; connections that arrive while it is full are closed right away
+     * on the accepting thread (see closing()).
+     */
+    class HTTPWorkerPool : public httplib::TaskQueue
+    {
+      public:
+        /**
+         * Creates the pool and starts the worker threads
+         *
+         * @param threads
+         * @param maximum_queued the number of connections that may wait for a worker
+         * @param rejected incremented each time a connection is turned away
+         * @param maximum_rejections the number of turned away connections that may wait for their 503
+         */
+        HTTPWorkerPool(
+            size_t threads,
+            size_t maximum_queued,
+            std::atomic<size_t> &rejected,
+            size_t maximum_rejections = Configuration::API::HTTP_MAXIMUM_QUEUED_REJECTIONS);
+
+        ~HTTPWorkerPool() override;
+
+        /**
+         * Returns whether the calling thread is closing a connection without a response
+         *
+         * @return
+         */
+        static bool closing();
+
+        /**
+         * Queues the connection for a worker thread, or for rejection if the queue is full,
+         * or closes it if the rejection queue is full too
+         *
+         * @param fn
+         */
+        void enqueue(std::function<void()> fn) override;
+
+        /**
+         * Returns whether the calling thread is answering requests with a 503
+         *
+         * @return
+         */
+        static bool rejecting();
+
+        /**
+         * Processes the remaining queued connections and stops the threads
+         */
+        void shutdown() override;
+
+      private:
+        /**
+         * The rejection thread
+         */
+        void rejector();
+
+        /**
+         * The worker threads
+         */
+        void worker();
+
+        size_t m_maximum_queued, m_maximum_rejections;
+
+        std::atomic<size_t> &m_rejected;
+
+        bool m_shutdown = false;
+
+        std::deque<std::function<void()>> m_queue, m_rejections;
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_queue_cv, m_rejections_cv;
+
+        std::vector<std::thread> m_workers;
+
+        std::thread m_rejector;
+    };
+} // namespace Networking
+
+#endif
@@ -4,6 +4,847 @@
 
 #include "node.h"
 
+#include <tools/thread_helper.h>
+
 namespace Node
 {
-}
+    Pipeline::Pipeline(
+        logger &logger,
+        std::shared_ptr<P2P::Node> &p2p,
+        std::shared_ptr<Core::BlockchainStorage> &blockchain_storage,
+        std::shared_ptr<Core::StakingEngine> &staking_engine,
+        std::shared_ptr<Core::VerifiedCache> verified_cache,
+        size_t workers):
+        m_running(false),
+        m_logger(logger),
+        m_p2p(p2p),
+        m_blockchain_storage(blockchain_storage),
+        m_staking_engine(staking_engine),
+        m_workers(std::max<size_t>(workers, 1)),
+        m_received(Configuration::Node::PIPELINE_QUEUE_DEPTH),
+        m_decoded(Configuration::Node::PIPELINE_QUEUE_DEPTH),
+        m_checked(Configuration::Node::PIPELINE_QUEUE_DEPTH),
+        m_validated(Configuration::Node::PIPELINE_QUEUE_DEPTH)
+    {
+        m_validator = std::make_shared<Core::TransactionValidator>(
+            m_blockchain_storage, m_staking_engine, std::move(verified_cache));
+    }
+
+    Pipeline::~Pipeline()
+    {
+        stop();
+    }
+
+    bool Pipeline::awaits_parent(const Error &error)
+    {
+        return error == DB_BLOCK_NOT_FOUND || error == DB_TRANSACTION_NOT_FOUND
+               || error == DB_TRANSACTION_OUTPUT_NOT_FOUND;
+    }
+
+    void Pipeline::check_stage()
+    {
+        entry_t entry;
+
+        while (m_decoded.pop(entry))
+        {
+            if (!entry.error)
+            {
+                const auto assume_valid = m_validator->assume_valid(entry.block.block_index);
+
+                // includes the verification of the producer and validator signatures unless assumed valid
+                if (!entry.block.validate_construction(!assume_valid))
+                {
+                    entry.error = MAKE_ERROR(BLOCK_INVALID_CONSTRUCTION);
+                }
+
+                for (const auto &transaction : entry.transactions)
+                {
+                    if (entry.error)
+                    {
+                        break;
+                    }
+
+                    entry.error = m_validator->check(transaction, assume_valid);
+                }
+
+                if (entry.error)
+                {
+                    m_check_counter.rejected++;
+                }
+                else
+                {
+                    m_check_counter.processed++;
+                }
+            }
+
+            // rejected entries continue on so that the validate stage does not wait on their sequence
+            if (!m_checked.push(std::move(entry)))
+            {
+                break;
+            }
+        }
+    }
+
+    Error Pipeline::decode(entry_t &entry)
+    {
+        try
+        {
+            deserializer_t reader(entry.payload);
+
+            entry.block = block_t(reader);
+
+            const auto count = reader.varint<uint64_t>();
+
+            if (count != entry.block.transactions.size())
+            {
+                return MAKE_ERROR(BLOCK_TXN_MISMATCH);
+            }
+
+            std::map<crypto_hash_t, transaction_t> transactions;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                transaction_t transaction;
+
+                // figure out what type of transaction it is
+                const auto type = reader.varint<uint64_t>(true);
+
+                switch (type)
+                {
+                    case TransactionType::GENESIS:
+                        transaction = genesis_transaction_t(reader);
+                        break;
+                    case TransactionType::STAKER:
+                        transaction = staker_transaction_t(reader);
+                        break;
+                    case TransactionType::NORMAL:
+                        transaction = committed_normal_transaction_t(reader);
+                        break;
+                    case TransactionType::STAKE:
+                        transaction = committed_stake_transaction_t(reader);
+                        break;
+                    case TransactionType::RECALL_STAKE:
+                        transaction = committed_recall_stake_transaction_t(reader);
+                        break;
+                    case TransactionType::STAKE_REFUND:
+                        transaction = stake_refund_transaction_t(reader);
+                        break;
+                    default:
+                        return MAKE_ERROR(UNKNOWN_TRANSACTION_TYPE);
+                }
+
+                const auto txn_hash = std::visit([](auto &&arg) { return arg.hash(); }, transaction);
+
+                transactions.insert({txn_hash, transaction});
+            }
+
+            // BlockchainStorage::put_block requires the transactions in the same order as the block
+            for (const auto &txn_hash : entry.block.transactions)
+            {
+                if (transactions.find(txn_hash) == transactions.end())
+                {
+                    return MAKE_ERROR(BLOCK_TXN_MISMATCH);
+                }
+
+                entry.transactions.push_back(transactions.at(txn_hash));
+            }
+        }
+        catch (const std::exception &e)
+        {
+            return MAKE_ERROR_MSG(BLOCK_DECODE, e.what());
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    void Pipeline::decode_stage()
+    {
+        entry_t entry;
+
+        while (m_received.pop(entry))
+        {
+            entry.error = decode(entry);
+
+            entry.payload.clear();
+
+            if (entry.error)
+            {
+                m_decode_counter.rejected++;
+            }
+            else
+            {
+                m_decode_counter.processed++;
+            }
+
+            if (!m_decoded.push(std::move(entry)))
+            {
+                break;
+            }
+        }
+    }
+
+    void Pipeline::intake_stage()
+    {
+        while (m_running)
+        {
+            // only block packets are queued here, all other messages stay with their own handlers
+            auto &blocks = m_p2p->blocks();
+
+            while (m_running && !blocks.empty())
+            {
+                const auto message = blocks.pop();
+
+                submit(message.from, message.packet);
+            }
+
+            if (thread_sleep(m_stopping))
+            {
+                break;
+            }
+        }
+    }
+
+    std::vector<crypto_key_image_t> Pipeline::key_images(const std::vector<transaction_t> &transactions)
+    {
+        std::vector<crypto_key_image_t> results;
+
+        for (const auto &transaction : transactions)
+        {
+            std::visit(
+                [&results](auto &&arg)
+                {
+                    USEVARIANT(T, arg);
+
+                    if COMMITED_USER_TX_VARIANT (T)
+                    {
+                        results.insert(results.end(), arg.key_images.begin(), arg.key_images.end());
+                    }
+                },
+                transaction);
+        }
+
+        return results;
+    }
+
+    Error Pipeline::persist_staking(const block_t &block, const std::vector<transaction_t> &transactions)
+    {
+        if (std::holds_alternative<staker_transaction_t>(block.reward_tx))
+        {
+            std::vector<crypto_public_key_t> validators;
+
+            for (const auto &[public_key, signature] : block.validator_signatures)
+            {
+                validators.push_back(public_key);
+            }
+
+            auto error = m_staking_engine->process_staker_tx(
+                block.block_index,
+                std::get<staker_transaction_t>(block.reward_tx),
+                block.producer_public_key,
+                validators);
+
+            if (error)
+            {
+                return error;
+            }
+        }
+
+        for (const auto &transaction : transactions)
+        {
+            auto error = std::visit(
+                [&](auto &&arg)
+                {
+                    USEVARIANT(T, arg);
+
+                    if constexpr (std::is_same_v<T, committed_stake_transaction_t>)
+                    {
+                        return m_staking_engine->add_stake(block.block_index, arg);
+                    }
+                    else if constexpr (std::is_same_v<T, stake_refund_transaction_t>)
+                    {
+                        const auto [error, recall_tx, block_hash] =
+                            m_blockchain_storage->get_transaction(arg.recall_stake_tx);
+
+                        if (error)
+                        {
+                            return error;
+                        }
+
+                        if (!std::holds_alternative<committed_recall_stake_transaction_t>(recall_tx))
+                        {
+                            return MAKE_ERROR(TX_RECALL_STAKE_TX_HASH);
+                        }
+
+                        return m_staking_engine->del_stake(
+                            block.block_index, std::get<committed_recall_stake_transaction_t>(recall_tx), arg);
+                    }
+                    else
+                    {
+                        return MAKE_ERROR(SUCCESS);
+                    }
+                },
+                transaction);
+
+            if (error)
+            {
+                return error;
+            }
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    void Pipeline::persist(const std::vector<std::tuple<block_t, std::vector<transaction_t>>> &blocks)
+    {
+        // the blocks of the batch are written in a single database transaction
+        auto error = m_blockchain_storage->put_blocks(blocks);
+
+        const auto written = !error;
+
+        size_t persisted = 0;
+
+        while (!error && persisted < blocks.size())
+        {
+            const auto &[block, transactions] = blocks[persisted];
+
+            error = persist_staking(block, transactions);
+
+            if (!error)
+            {
+                persisted++;
+            }
+        }
+
+        if (error)
+        {
+            const auto &block = std::get<0>(blocks[persisted]);
+
+            m_logger->error("Could not persist block {0}: {1}", block.block_index, error.to_string());
+
+            {
+                std::unique_lock lock(m_inflight_mutex);
+
+                m_tip_stale = true;
+
+                m_epoch++;
+            }
+
+            /**
+             * The staking changes are written to their own database after the blocks, so the block
+             * that failed and those after it are rolled back along with any staking changes they made;
+             * there is nothing beneath the genesis block to roll back to
+             */
+            if (written && block.block_index != 0)
+            {
+                const auto rewind_error = rewind(block.block_index - 1);
+
+                if (rewind_error)
+                {
+                    m_logger->error(
+                        "Could not roll back block {0}: {1}", block.block_index, rewind_error.to_string());
+                }
+            }
+        }
+
+        m_persist_counter.processed += persisted;
+
+        m_persist_counter.rejected += blocks.size() - persisted;
+    }
+
+    void Pipeline::persist_stage()
+    {
+        std::vector<entry_t> batch;
+
+        while (m_validated.pop(batch, Configuration::Node::PIPELINE_PERSIST_BATCH) != 0)
+        {
+            uint64_t epoch;
+
+            {
+                std::unique_lock lock(m_inflight_mutex);
+
+                epoch = m_epoch;
+            }
+
+            std::vector<std::tuple<block_t, std::vector<transaction_t>>> blocks;
+
+            for (auto &entry : batch)
+            {
+                // the block was built upon a block that failed to persist
+                if (entry.epoch != epoch)
+                {
+                    m_persist_counter.rejected++;
+
+                    release(entry.transactions);
+
+                    continue;
+                }
+
+                blocks.emplace_back(std::move(entry.block), std::move(entry.transactions));
+            }
+
+            if (!blocks.empty())
+            {
+                persist(blocks);
+            }
+
+            for (const auto &[block, transactions] : blocks)
+            {
+                release(transactions);
+            }
+
+            batch.clear();
+        }
+    }
+
+    void Pipeline::release(const std::vector<transaction_t> &transactions)
+    {
+        {
+            std::unique_lock lock(m_inflight_mutex);
+
+            for (const auto &key_image : key_images(transactions))
+            {
+                m_inflight_key_images.erase(key_image);
+            }
+
+            m_inflight_blocks--;
+        }
+
+        m_inflight_cv.notify_all();
+    }
+
+    void Pipeline::report_stats()
+    {
+        std::map<std::string, size_t> previous;
+
+        auto last = std::chrono::steady_clock::now();
+
+        while (m_running)
+        {
+            if (thread_sleep(m_stopping, Configuration::Node::PIPELINE_STATS_INTERVAL))
+            {
+                break;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+
+            const auto elapsed = std::chrono::duration<double>(now - last).count();
+
+            last = now;
+
+            for (const auto &stage : stats())
+            {
+                const auto rate = (elapsed > 0) ? (stage.processed - previous[stage.name]) / elapsed : 0.0;
+
+                previous[stage.name] = stage.processed;
+
+                m_logger->info(
+                    "Pipeline {0}: {1:.2f}/s, {2} processed, {3} rejected, {4}/{5} queued, {6} stalls",
+                    stage.name,
+                    rate,
+                    stage.processed,
+                    stage.rejected,
+                    stage.queued,
+                    stage.capacity,
+                    stage.stalls);
+            }
+        }
+    }
+
+    Error Pipeline::rewind(uint64_t block_index)
+    {
+        m_logger->warn("Rewinding the chain to block {0}", block_index);
+
+        auto error = m_blockchain_storage->rewind(block_index);
+
+        if (error)
+        {
+            return error;
+        }
+
+        error = m_staking_engine->rewind(block_index);
+
+        if (error)
+        {
+            return error;
+        }
+
+        // transactions verified for the blocks above the block index may reference outputs that no longer exist
+        m_validator->verified_cache()->rewind(block_index + 1);
+
+        if (m_http_server)
+        {
+            m_http_server->response_cache()->rewind(block_index);
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    bool Pipeline::running() const
+    {
+        return m_running;
+    }
+
+    void Pipeline::set_assume_valid(const crypto_hash_t &block_hash, uint64_t block_index)
+    {
+        m_validator->set_assume_valid(block_hash, block_index);
+    }
+
+    void Pipeline::set_http_server(std::shared_ptr<Networking::HTTPServer> server)
+    {
+        m_http_server = std::move(server);
+
+        m_wallet_sync_api = std::make_unique<WalletSyncAPI>(m_logger, m_http_server, m_blockchain_storage);
+    }
+
+    Error Pipeline::start()
+    {
+        if (!m_running)
+        {
+            const auto count = m_blockchain_storage->get_block_count();
+
+            m_has_tip = (count != 0);
+
+            if (m_has_tip)
+            {
+                const auto [error, block_hash] = m_blockchain_storage->get_block_hash(count - 1);
+
+                if (error)
+                {
+                    return error;
+                }
+
+                m_tip_index = count - 1;
+
+                m_tip_hash = block_hash;
+            }
+
+            m_running = true;
+
+            m_threads.emplace_back(&Pipeline::intake_stage, this);
+
+            for (size_t i = 0; i < m_workers; ++i)
+            {
+                m_threads.emplace_back(&Pipeline::decode_stage, this);
+
+                m_threads.emplace_back(&Pipeline::check_stage, this);
+            }
+
+            m_threads.emplace_back(&Pipeline::validate_stage, this);
+
+            m_threads.emplace_back(&Pipeline::persist_stage, this);
+
+            m_threads.emplace_back(&Pipeline::report_stats, this);
+
+            m_logger->debug("Node pipeline started with {0} workers per parallel stage", m_workers);
+        }
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    std::vector<stage_stats_t> Pipeline::stats() const
+    {
+        std::vector<stage_stats_t> results;
+
+        const auto add = [&results](
+                             const std::string &name,
+                             size_t workers,
+                             const stage_counter_t &counter,
+                             size_t queued,
+                             size_t capacity,
+                             size_t stalls)
+        {
+            stage_stats_t stage;
+
+            stage.name = name;
+
+            stage.workers = workers;
+
+            stage.processed = counter.processed;
+
+            stage.rejected = counter.rejected;
+
+            stage.queued = queued;
+
+            stage.capacity = capacity;
+
+            stage.stalls = stalls;
+
+            results.push_back(stage);
+        };
+
+        add("intake", 1, m_intake_counter, m_p2p->blocks().size(), 0, m_received.stalls());
+
+        add("decode", m_workers, m_decode_counter, m_received.size(), m_received.capacity(), m_decoded.stalls());
+
+        add("check", m_workers, m_check_counter, m_decoded.size(), m_decoded.capacity(), m_checked.stalls());
+
+        add("validate", 1, m_validate_counter, m_checked.size(), m_checked.capacity(), m_validated.stalls());
+
+        add("persist", 1, m_persist_counter, m_validated.size(), m_validated.capacity(), 0);
+
+        return results;
+    }
+
+    void Pipeline::stop()
+    {
+        if (!m_running)
+        {
+            return;
+        }
+
+        m_logger->debug("Shutting down node pipeline");
+
+        m_running = false;
+
+        m_stopping.notify_all();
+
+        m_received.close();
+
+        m_decoded.close();
+
+        m_checked.close();
+
+        m_validated.close();
+
+        m_inflight_cv.notify_all();
+
+        for (auto &thread : m_threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+
+        m_threads.clear();
+
+        m_logger->debug("Node pipeline shutdown complete");
+    }
+
+    bool Pipeline::submit(const crypto_hash_t &from, const Types::Network::packet_data_t &packet)
+    {
+        if (packet.type() != BaseTypes::NETWORK_BLOCK)
+        {
+            return false;
+        }
+
+        entry_t entry;
+
+        entry.sequence = m_sequence++;
+
+        entry.from = from;
+
+        entry.payload = packet.payload;
+
+        if (!m_received.push(std::move(entry)))
+        {
+            return false;
+        }
+
+        m_intake_counter.processed++;
+
+        return true;
+    }
+
+    Error Pipeline::validate(entry_t &entry)
+    {
+        const auto &block = entry.block;
+
+        // conflicts within the block fail fast before any database access
+        const auto [collect_error, block_key_images] = Core::BlockchainStorage::collect_key_images(entry.transactions);
+
+        if (collect_error)
+        {
+            return collect_error;
+        }
+
+        {
+            std::unique_lock lock(m_inflight_mutex);
+
+            // a block we built upon failed to persist; start over from what is actually in the database
+            if (m_tip_stale)
+            {
+                m_inflight_cv.wait(lock, [this] { return m_inflight_blocks == 0 || !m_running; });
+
+                const auto count = m_blockchain_storage->get_block_count();
+
+                m_has_tip = (count != 0);
+
+                if (m_has_tip)
+                {
+                    const auto [error, block_hash] = m_blockchain_storage->get_block_hash(count - 1);
+
+                    m_tip_index = count - 1;
+
+                    m_tip_hash = block_hash;
+                }
+
+                m_tip_stale = false;
+            }
+
+            if (m_has_tip ? (block.block_index != m_tip_index + 1 || block.previous_blockhash != m_tip_hash)
+                          : block.block_index != 0)
+            {
+                /**
+                 * The blocks below the assume valid checkpoint skipped their signature checks; the
+                 * checkpoint block itself cannot be forged, so if it arrives in place of the next block
+                 * but does not extend the tip then the most recently assumed valid blocks are not its
+                 * ancestors and are rewound once they have been persisted
+                 */
+                if (m_has_tip && block.block_index == m_tip_index + 1
+                    && m_validator->assume_valid_checkpoint(block.block_index, block.hash()))
+                {
+                    m_inflight_cv.wait(lock, [this] { return m_inflight_blocks == 0 || !m_running; });
+
+                    if (!m_running)
+                    {
+                        return MAKE_ERROR(BLOCK_NOT_NEXT);
+                    }
+
+                    // the genesis block is never assumed valid
+                    const auto block_index = (m_tip_index > m_assume_valid_rewind_depth)
+                                                 ? m_tip_index - m_assume_valid_rewind_depth
+                                                 : 0;
+
+                    const auto rewind_error = rewind(block_index);
+
+                    if (rewind_error)
+                    {
+                        m_logger->error("Could not rewind the assumed valid blocks: {0}", rewind_error.to_string());
+                    }
+
+                    // if the chain still does not link up with the checkpoint, go further back next time
+                    m_assume_valid_rewind_depth *= 2;
+
+                    m_tip_stale = true;
+                }
+
+                return MAKE_ERROR(BLOCK_NOT_NEXT);
+            }
+
+            // any other block at the checkpoint index is rejected on its own, the peer is penalized for it
+            auto error = m_validator->check_assume_valid(block.block_index, block.hash());
+
+            if (error)
+            {
+                return error;
+            }
+
+            for (const auto &key_image : block_key_images)
+            {
+                if (m_inflight_key_images.find(key_image) != m_inflight_key_images.end())
+                {
+                    return MAKE_ERROR(TX_KEY_IMAGE_PENDING);
+                }
+            }
+        }
+
+        const auto validate_transactions = [&]()
+        { return m_validator->validate(block.block_index, entry.transactions); };
+
+        auto error = validate_transactions();
+
+        if (awaits_parent(error))
+        {
+            /**
+             * The transactions may reference outputs, or transactions, created by blocks that are
+             * still waiting to be persisted; wait for the persist stage to catch up and try once more
+             */
+            std::unique_lock lock(m_inflight_mutex);
+
+            if (m_inflight_blocks != 0)
+            {
+                m_inflight_cv.wait(lock, [this] { return m_inflight_blocks == 0 || !m_running; });
+
+                lock.unlock();
+
+                error = validate_transactions();
+            }
+        }
+
+        if (error)
+        {
+            return error;
+        }
+
+        std::unique_lock lock(m_inflight_mutex);
+
+        // the block we validated against failed to persist while we were working
+        if (m_tip_stale)
+        {
+            return MAKE_ERROR(BLOCK_NOT_NEXT);
+        }
+
+        for (const auto &key_image : block_key_images)
+        {
+            m_inflight_key_images.insert({key_image, block.block_index});
+        }
+
+        m_inflight_blocks++;
+
+        entry.epoch = m_epoch;
+
+        m_has_tip = true;
+
+        m_tip_index = block.block_index;
+
+        m_tip_hash = block.hash();
+
+        return MAKE_ERROR(SUCCESS);
+    }
+
+    void Pipeline::validate_stage()
+    {
+        // entries that arrived ahead of their turn, keyed by intake sequence
+        std::map<uint64_t, entry_t> pending;
+
+        uint64_t next_sequence = 0;
+
+        entry_t entry;
+
+        while (m_checked.pop(entry))
+        {
+            pending.insert({entry.sequence, std::move(entry)});
+
+            while (!pending.empty() && pending.begin()->first == next_sequence)
+            {
+                auto current = std::move(pending.begin()->second);
+
+                pending.erase(pending.begin());
+
+                next_sequence++;
+
+                if (!current.error)
+                {
+                    current.error = validate(current);
+
+                    if (current.error)
+                    {
+                        m_validate_counter.rejected++;
+                    }
+                }
+
+                if (current.error)
+                {
+                    m_logger->debug(
+                        "Rejected block from {0}: {1}", current.from.to_string(), current.error.to_string());
+
+                    // only a forged block contradicts the assume valid checkpoint
+                    if (current.error == BLOCK_ASSUME_VALID_MISMATCH)
+                    {
+                        m_p2p->penalize(current.from);
+                    }
+
+                    continue;
+                }
+
+                m_validate_counter.processed++;
+
+                if (!m_validated.push(std::move(current)))
+                {
+                    return;
+                }
+            }
+        }
+    }
+} // namespace Node
@@ -5,8 +5,325 @@
 #ifndef TURTLECOIN_NODE_H
 #define TURTLECOIN_NODE_H
 
+#include <blockchain_storage.h>
+#include <condition_variable>
+#include <config.h>
+#include <errors.h>
+#include <logger.h>
+#include <p2p_node.h>
+#include <staking_engine.h>
+#include <tools/thread_safe_bounded_queue.h>
+#include <transaction_validator.h>
+#include <wallet_sync_api.h>
+
 namespace Node
 {
-}
+    /**
+     * Point in time statistics of a single pipeline stage
+     */
+    struct stage_stats_t
+    {
+        std::string name;
+
+        size_t workers = 0;
+
+        // the number of entries that left the stage
+        size_t processed = 0;
+
+        // the number of entries that the stage rejected
+        size_t rejected = 0;
+
+        // the number of entries waiting in the queue feeding the stage
+        size_t queued = 0;
+
+        size_t capacity = 0;
+
+        // the number of times the stage had to wait because the next stage was full
+        size_t stalls = 0;
+    };
+
+    /**
+     * The block processing pipeline of the full node
+     *
+     * Blocks received from the P2P network move through the following stages, each
+     * connected to the next by a bounded queue so that a slow stage pushes back on
+     * the stages before it rather than allowing memory to grow without limit:
+     *
+     *   intake   -> pulls block packets from the P2P node (1 thread)
+     *   decode   -> deserializes the block and its transactions (N threads)
+     *   check    -> stateless checks: block construction, signatures, and check() of
+     *               every transaction (N threads)
+     *   validate -> stateful validation against the chain in block order (1 thread)
+     *   persist  -> writes batches of validated blocks in a single database transaction
+     *               followed by their staking changes (1 thread)
+     *
+     * The payload of a block packet (a data packet of the NETWORK_BLOCK type) is the
+     * serialized block followed by the number of transactions (varint) and each
+     * serialized transaction.
+     *
+     * The parallel stages may reorder blocks so the validate stage restores the
+     * intake order using the sequence number assigned at intake. Key images spent
+     * by blocks that have been validated but not yet persisted are tracked so that
+     * validation may run ahead of the persist stage.
+     */
+    class Pipeline
+    {
+      public:
+        /**
+         * Constructs a new instance of the node pipeline
+         *
+         * @param logger
+         * @param p2p
+         * @param blockchain_storage
+         * @param staking_engine
+         * @param verified_cache shared with the transaction pool so that verified transactions are not checked twice
+         * @param workers the number of threads used by each of the parallel stages
+         */
+        Pipeline(
+            logger &logger,
+            std::shared_ptr<P2P::Node> &p2p,
+            std::shared_ptr<Core::BlockchainStorage> &blockchain_storage,
+            std::shared_ptr<Core::StakingEngine> &staking_engine,
+            std::shared_ptr<Core::VerifiedCache> verified_cache = nullptr,
+            size_t workers = std::thread::hardware_concurrency());
+
+        ~Pipeline();
+
+        /**
+         * Returns if the pipeline is running
+         *
+         * @return
+         */
+        [[nodiscard]] bool running() const;
+
+        /**
+         * Sets the assume valid checkpoint used during sync, an empty hash disables the checkpoint
+         *
+         * NOTE: must be called before the pipeline is started
+         *
+         * @param block_hash
+         * @param block_index
+         */
+        void set_assume_valid(const crypto_hash_t &block_hash, uint64_t block_index);
+
+        /**
+         * Registers the node APIs (e.g. wallet sync) with the HTTP server; the response cache
+         * of the server is then rewound along with the chain
+         *
+         * NOTE: must be called before the pipeline is started
+         *
+         * @param server
+         */
+        void set_http_server(std::shared_ptr<Networking::HTTPServer> server);
+
+        /**
+         * Starts the pipeline threads
+         *
+         * @return
+         */
+        Error start();
+
+        /**
+         * Returns the current statistics of each stage of the pipeline in pipeline order
+         *
+         * @return
+         */
+        [[nodiscard]] std::vector<stage_stats_t> stats() const;
+
+        /**
+         * Stops the pipeline, entries already in flight are discarded
+         */
+        void stop();
+
+        /**
+         * Places the block packet into the pipeline as if it was received from the P2P network,
+         * packets of any other type are refused
+         *
+         * @param from
+         * @param packet
+         * @return
+         */
+        bool submit(const crypto_hash_t &from, const Types::Network::packet_data_t &packet);
+
+      private:
+        struct entry_t
+        {
+            uint64_t sequence = 0;
+
+            crypto_hash_t from;
+
+            std::vector<uint8_t> payload;
+
+            block_t block;
+
+            std::vector<transaction_t> transactions;
+
+            // the validation epoch the entry was validated in
+            uint64_t epoch = 0;
+
+            Error error;
+        };
+
+        struct stage_counter_t
+        {
+            std::atomic<size_t> processed = 0, rejected = 0;
+        };
+
+        /**
+         * Returns whether the validation error may be caused by a parent block that has been
+         * validated but not yet persisted, in which case the validation is worth retrying
+         *
+         * @param error
+         * @return
+         */
+        static bool awaits_parent(const Error &error);
+
+        /**
+         * The check stage worker thread
+         */
+        void check_stage();
+
+        /**
+         * Deserializes the block and transactions contained in the entry payload
+         *
+         * @param entry
+         * @return
+         */
+        static Error decode(entry_t &entry);
+
+        /**
+         * The decode stage worker thread
+         */
+        void decode_stage();
+
+        /**
+         * The intake stage thread
+         */
+        void intake_stage();
+
+        /**
+         * Returns the key images spent by the transactions
+         *
+         * @param transactions
+         * @return
+         */
+        static std::vector<crypto_key_image_t> key_images(const std::vector<transaction_t> &transactions);
+
+        /**
+         * Writes the blocks in a single database transaction followed by their staking changes;
+         * if the staking changes of a block fail, that block and the blocks after it are rolled
+         * back so that the blocks and the staking state never disagree
+         *
+         * @param blocks
+         */
+        void persist(const std::vector<std::tuple<block_t, std::vector<transaction_t>>> &blocks);
+
+        /**
+         * Applies the staking changes of the transactions in the block
+         *
+         * @param block
+         * @param transactions
+         * @return
+         */
+        Error persist_staking(const block_t &block, const std::vector<transaction_t> &transactions);
+
+        /**
+         * The persist stage thread
+         */
+        void persist_stage();
+
+        /**
+         * Releases the in-flight key images of the transactions of a block and signals the validate stage
+         *
+         * @param transactions
+         */
+        void release(const std::vector<transaction_t> &transactions);
+
+        /**
+         * The statistics reporting thread
+         */
+        void report_stats();
+
+        /**
+         * Rewinds the chain to the given block index; this is the single path by which the
+         * node rewinds and it rewinds everything that holds state derived from the chain
+         *
+         * NOTE: the persist stage must be idle, or be the caller
+         *
+         * @param block_index
+         * @return
+         */
+        Error rewind(uint64_t block_index);
+
+        /**
+         * Performs the stateful validation of the entry against the current chain
+         * and the blocks that are still waiting to be persisted; on success the entry
+         * is stamped with the current validation epoch
+         *
+         * @param entry
+         * @return
+         */
+        Error validate(entry_t &entry);
+
+        /**
+         * The validate stage thread
+         */
+        void validate_stage();
+
+        std::atomic<bool> m_running;
+
+        logger m_logger;
+
+        std::shared_ptr<P2P::Node> m_p2p;
+
+        std::shared_ptr<Core::BlockchainStorage> m_blockchain_storage;
+
+        std::shared_ptr<Core::StakingEngine> m_staking_engine;
+
+        std::shared_ptr<Core::TransactionValidator> m_validator;
+
+        std::shared_ptr<Networking::HTTPServer> m_http_server;
+
+        std::unique_ptr<WalletSyncAPI> m_wallet_sync_api;
+
+        size_t m_workers;
+
+        std::atomic<uint64_t> m_sequence = 0;
+
+        ThreadSafeBoundedQueue<entry_t> m_received, m_decoded, m_checked, m_validated;
+
+        stage_counter_t m_intake_counter, m_decode_counter, m_check_counter, m_validate_counter, m_persist_counter;
+
+        // the top of the chain as seen by the validate stage
+        uint64_t m_tip_index = 0;
+
+        crypto_hash_t m_tip_hash;
+
+        bool m_has_tip = false;
+
+        // the number of assumed valid blocks rewound when the checkpoint block does not extend the chain
+        uint64_t m_assume_valid_rewind_depth = Configuration::Node::ASSUME_VALID_REWIND_DEPTH;
+
+        // the following are guarded by the in-flight mutex
+
+        // set when the persist stage fails to write a block that the validate stage built upon
+        bool m_tip_stale = false;
+
+        uint64_t m_epoch = 0;
+
+        // key images (and the block index spending them) of validated blocks that are not yet persisted
+        std::map<crypto_key_image_t, uint64_t> m_inflight_key_images;
+
+        size_t m_inflight_blocks = 0;
+
+        std::mutex m_inflight_mutex;
+
+        std::condition_variable m_inflight_cv;
+
+        std::vector<std::thread> m_threads;
+
+        std::condition_variable m_stopping;
+    };
+} // namespace Node
 
 #endif // TURTLECOIN_NODE_H
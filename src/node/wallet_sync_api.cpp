@@ -0,0 +1,133 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "wallet_sync_api.h"
+
+namespace Node
+{
+    WalletSyncAPI::WalletSyncAPI(
+        logger &logger,
+        std::shared_ptr<Networking::HTTPServer> &server,
+        std::shared_ptr<Core::BlockchainStorage> &blockchain_storage):
+        m_logger(logger), m_server(server), m_blockchain_storage(blockchain_storage)
+    {
+        m_server->Get(
+            R"(/sync/(\d+)/(\d+))",
+            [this](const httplib::Request &request, httplib::Response &response)
+            { get_sync_data(request, response); });
+    }
+
+    void WalletSyncAPI::get_sync_data(const httplib::Request &request, httplib::Response &response)
+    {
+        uint64_t start_index;
+
+        size_t count;
+
+        try
+        {
+            start_index = std::stoull(request.matches[1]);
+
+            count = std::stoull(request.matches[2]);
+        }
+        catch (...)
+        {
+            response.status = 400;
+
+            return;
+        }
+
+        count = std::min(count, Configuration::API::MAXIMUM_SYNC_DATA_BLOCKS);
+
+        if (count == 0 || !m_blockchain_storage->block_exists(start_index))
+        {
+            response.status = 404;
+
+            return;
+        }
+
+        // a range that ends below the top block does not change unless the chain is rewound
+        if (start_index + count < m_blockchain_storage->get_block_count())
+        {
+            const auto resource = std::to_string(start_index) + "/" + std::to_string(count);
+
+            const auto cache = m_server->response_cache();
+
+            if (cache->get(request, response, resource, "sync"))
+            {
+                return;
+            }
+
+            std::string body;
+
+            for (uint64_t index = start_index; index < start_index + count;)
+            {
+                const auto [error, data, blocks] = m_blockchain_storage->get_sync_data(
+                    index, std::min(start_index + count - index, Configuration::API::SYNC_DATA_CHUNK_BLOCKS));
+
+                if (error || blocks == 0)
+                {
+                    m_logger->debug(
+                        "Could not retrieve the wallet sync data of block {0}: {1}", index, error.to_string());
+
+                    response.status = 500;
+
+                    return;
+                }
+
+                body.append(reinterpret_cast<const char *>(data.data()), data.size());
+
+                index += blocks;
+            }
+
+            cache->put(
+                request,
+                response,
+                resource,
+                "sync",
+                start_index + count - 1,
+                std::move(body),
+                "application/octet-stream");
+
+            return;
+        }
+
+        // the next block index to send and the number of blocks that remain to be sent
+        auto next_index = std::make_shared<uint64_t>(start_index);
+
+        auto remaining = std::make_shared<size_t>(count);
+
+        response.set_chunked_content_provider(
+            "application/octet-stream",
+            [this, next_index, remaining](size_t offset, httplib::DataSink &sink)
+            {
+                const auto [error, data, blocks] = m_blockchain_storage->get_sync_data(
+                    *next_index, std::min(*remaining, Configuration::API::SYNC_DATA_CHUNK_BLOCKS));
+
+                // the range may not begin past the top of the chain; however, a rewind may pull the top below it
+                if (error && error != DB_BLOCK_NOT_FOUND)
+                {
+                    m_logger->debug(
+                        "Could not retrieve the wallet sync data of block {0}: {1}", *next_index, error.to_string());
+
+                    return false;
+                }
+
+                if (!data.empty() && !sink.write(reinterpret_cast<const char *>(data.data()), data.size()))
+                {
+                    return false;
+                }
+
+                *next_index += blocks;
+
+                *remaining -= blocks;
+
+                if (blocks == 0 || *remaining == 0)
+                {
+                    sink.done();
+                }
+
+                return true;
+            });
+    }
+} // namespace Node
@@ -0,0 +1,62 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_NODE_WALLET_SYNC_API_H
+#define TURTLECOIN_NODE_WALLET_SYNC_API_H
+
+#include <blockchain_storage.h>
+#include <config.h>
+#include <http_server.h>
+#include <logger.h>
+
+namespace Node
+{
+    /**
+     * Serves the compact wallet sync data of the chain so that wallets do not have to
+     * retrieve full blocks and transactions to scan for their outputs
+     *
+     *   GET /sync/{start_index}/{count}
+     *
+     * The response body is the binary encoding of the sync data of each block in the
+     * requested range, one after another, and is streamed to the client in chunks of
+     * SYNC_DATA_CHUNK_BLOCKS blocks. The range is limited to MAXIMUM_SYNC_DATA_BLOCKS
+     * blocks and stops early at the top of the chain; the client reads until the end
+     * of the body.
+     *
+     * Ranges that end below the top block are served in full from the response cache
+     * of the server, which must be rewound along with the blockchain.
+     */
+    class WalletSyncAPI
+    {
+      public:
+        /**
+         * Registers the wallet sync routes with the HTTP server
+         *
+         * @param logger
+         * @param server
+         * @param blockchain_storage
+         */
+        WalletSyncAPI(
+            logger &logger,
+            std::shared_ptr<Networking::HTTPServer> &server,
+            std::shared_ptr<Core::BlockchainStorage> &blockchain_storage);
+
+      private:
+        /**
+         * Handles requests for the wallet sync data of a range of blocks
+         *
+         * @param request
+         * @param response
+         */
+        void get_sync_data(const httplib::Request &request, httplib::Response &response);
+
+        logger m_logger;
+
+        std::shared_ptr<Networking::HTTPServer> m_server;
+
+        std::shared_ptr<Core::BlockchainStorage> m_blockchain_storage;
+    };
+} // namespace Node
+
+#endif // TURTLECOIN_NODE_WALLET_SYNC_API_H
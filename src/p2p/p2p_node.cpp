@@ -72,6 +72,11 @@ namespace P2P
         m_logger->debug("P2P Network Node shutdown complete");
     }
 
+    ThreadSafeQueue<network_msg_t> &Node::blocks()
+    {
+        return m_blocks;
+    }
+
     packet_handshake_t Node::build_handshake() const
     {
         packet_handshake_t packet(m_peer_db->peer_id(), m_server->port(), m_network_id);
@@ -218,6 +223,7 @@ namespace P2P
                 case NetworkPacketTypes::NETWORK_KEEPALIVE:
                     return handle_packet(message.from, message.peer_address, packet_keepalive_t(reader), is_server);
                 case NetworkPacketTypes::NETWORK_DATA:
+                case NetworkPacketTypes::NETWORK_BLOCK:
                     return handle_packet(message.from, message.peer_address, packet_data_t(reader), is_server);
                 default:
                     throw std::runtime_error("Unknown packet type detected");
@@ -320,6 +326,12 @@ namespace P2P
             return;
         }
 
+        // we no longer listen to peers that sent us forged data
+        if (m_penalized.contains(from))
+        {
+            return;
+        }
+
         // we don't talk to ourselves
         if (from == m_server->identity())
         {
@@ -334,6 +346,14 @@ namespace P2P
             return;
         }
 
+        // blocks are processed by the node pipeline, everything else by the message handlers
+        if (packet.type() == NetworkPacketTypes::NETWORK_BLOCK)
+        {
+            m_blocks.push(network_msg_t(from, packet, is_server));
+
+            return;
+        }
+
         // add the message to the stack for processing
         m_messages.push(network_msg_t(from, packet, is_server));
     }
@@ -482,6 +502,13 @@ namespace P2P
         return m_peer_db;
     }
 
+    void Node::penalize(const crypto_hash_t &from)
+    {
+        m_logger->debug("Ignoring the data packets of peer: {0}", from.to_string());
+
+        m_penalized.insert(from);
+    }
+
     uint16_t Node::port() const
     {
         return m_server->port();
@@ -50,6 +50,13 @@ namespace P2P
 
         ~Node();
 
+        /**
+         * Returns the current queue of block packets to be processed
+         *
+         * @return
+         */
+        ThreadSafeQueue<network_msg_t> &blocks();
+
         /**
          * Returns the nodes external IP address if available
          *
@@ -72,7 +79,7 @@ namespace P2P
         size_t incoming_connections() const;
 
         /**
-         * Returns the current queue of network messages to be processed
+         * Returns the current queue of network messages, other than blocks, to be processed
          *
          * @return
          */
@@ -106,6 +113,14 @@ namespace P2P
          */
         std::shared_ptr<PeerDB> peers() const;
 
+        /**
+         * Stops processing the data packets received from the specified connection, used
+         * when a peer sends data that could only have been forged
+         *
+         * @param from
+         */
+        void penalize(const crypto_hash_t &from);
+
         /**
          * Returns the nodes bind port
          *
@@ -275,9 +290,9 @@ namespace P2P
 
         ThreadSafeMap<crypto_hash_t, std::shared_ptr<Networking::ZMQClient>> m_clients;
 
-        ThreadSafeSet<crypto_hash_t> m_completed_handshake;
+        ThreadSafeSet<crypto_hash_t> m_completed_handshake, m_penalized;
 
-        ThreadSafeQueue<network_msg_t> m_messages;
+        ThreadSafeQueue<network_msg_t> m_messages, m_blocks;
 
         std::thread m_poller_thread, m_keepalive_thread, m_peer_exchange_thread, m_connection_manager_thread;
 
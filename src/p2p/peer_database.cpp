@@ -145,24 +145,21 @@ namespace P2P
     {
         std::scoped_lock lock(m_mutex);
 
-        auto peers = m_database->get_all<network_peer_t>();
+        std::vector<network_peer_t> peers;
 
-        /**
-         * We were asked for peers for a specific network ID
-         * then we need to filter the results to just those
-         * peers that are participating in that network ID
-         */
-        if (!network_id.empty())
+        for (auto &entry : m_database->iterate())
         {
-            std::vector<network_peer_t> temp;
-
-            std::copy_if(
-                peers.begin(),
-                peers.end(),
-                std::back_inserter(temp),
-                [=](const auto &elem) { return elem.network_id == network_id; });
-
-            peers = temp;
+            const auto peer = network_peer_t(entry.value);
+
+            /**
+             * We were asked for peers for a specific network ID
+             * then we need to filter the results to just those
+             * peers that are participating in that network ID
+             */
+            if (network_id.empty() || peer.network_id == network_id)
+            {
+                peers.push_back(peer);
+            }
         }
 
         const auto seed = std::chrono::system_clock::now().time_since_epoch().count();
@@ -180,27 +177,53 @@ namespace P2P
 
     void PeerDB::prune()
     {
-        const auto all_peers = peers();
-
         const auto prune_time = (time(nullptr)) - Configuration::P2P::PEER_PRUNE_TIME;
 
-        if (!all_peers.empty())
-        {
-            m_logger->trace("Starting peer list pruning...");
-        }
+        std::scoped_lock lock(m_mutex);
+
+        std::vector<crypto_hash_t> stale_peers;
 
-        for (const auto &peer : all_peers)
+        // the read transaction of the iterator must be closed before the write transaction is opened
+        for (auto &entry : m_database->iterate())
         {
+            const auto peer = network_peer_t(entry.value);
+
             if (peer.last_seen < prune_time)
             {
-                auto error = del(peer.peer_id);
+                stale_peers.push_back(peer.peer_id);
+            }
+        }
 
-                if (error)
-                {
-                    m_logger->debug("Error deleting peer {0}: {1}", peer.peer_id.to_string(), error.to_string());
-                }
+        if (stale_peers.empty())
+        {
+            return;
+        }
+
+        m_logger->trace("Pruning {0} peers from the peer list...", stale_peers.size());
+
+    try_again:
+        auto txn = m_database->transaction();
+
+        for (const auto &peer_id : stale_peers)
+        {
+            auto error = txn->del(peer_id);
+
+            MDB_CHECK_TXN_EXPAND(error, m_env, txn, try_again);
+
+            if (error && error != LMDB_NOTFOUND)
+            {
+                m_logger->debug("Error deleting peer {0}: {1}", peer_id.to_string(), error.to_string());
             }
         }
+
+        auto error = txn->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, m_env, txn, try_again);
+
+        if (error)
+        {
+            m_logger->debug("Error pruning the peer list: {0}", error.to_string());
+        }
     }
 
     Error PeerDB::touch(const crypto_hash_t &peer_id)
@@ -0,0 +1,612 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include <benchmark_suite.h>
+#include <blockchain_storage.h>
+#include <chain_generator.h>
+#include <cli_helper.h>
+#include <config.h>
+#include <cppfs/FileHandle.h>
+#include <cppfs/fs.h>
+#include <db_lmdb.h>
+#include <iostream>
+#include <staking_engine.h>
+#include <tools/thread_safe_bounded_queue.h>
+#include <tools/thread_safe_deque.h>
+#include <tools/thread_safe_map.h>
+#include <tools/thread_safe_queue.h>
+#include <tools/thread_safe_set.h>
+#include <transaction_validator.h>
+#include <types.h>
+
+#define LMDB_VALUE_SIZE 128
+#define LMDB_FILL_BATCH 10'000
+#define LMDB_CURSOR_WALK 100
+#define STORAGE_BLOCKS 200
+#define STORAGE_TRANSACTIONS_PER_BLOCK 8
+#define VALIDATOR_TRANSACTIONS 4
+#define VALIDATOR_ITERATIONS 5
+#define CONTENTION_OPERATIONS 10'000
+
+using namespace Types::Blockchain;
+
+static crypto_hash_t random_hash(std::mt19937_64 &random)
+{
+    const auto value = random();
+
+    return Crypto::Hashing::sha3(&value, sizeof(value));
+}
+
+/**
+ * Keys are derived from the seeded generator rather than the system RNG so
+ * that every run of the benchmarks operates on exactly the same data
+ */
+static crypto_public_key_t random_key(std::mt19937_64 &random)
+{
+    return Crypto::secret_key_to_public_key(crypto_scalar_t(random()));
+}
+
+/**
+ * The timing of a call that failed says nothing about the call that succeeds, so a
+ * failure aborts the run rather than recording a result that cannot be compared
+ */
+static void abort_on_error(const std::string &name, const Error &error)
+{
+    if (error)
+    {
+        std::cout << std::endl << name << " failed: " << error << std::endl;
+
+        exit(1);
+    }
+}
+
+static serializer_t random_bytes(std::mt19937_64 &random, size_t count)
+{
+    serializer_t writer;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        writer.uint8(static_cast<uint8_t>(random()));
+    }
+
+    return writer;
+}
+
+static void fill_database(
+    std::shared_ptr<Database::LMDBDatabase> &db,
+    std::vector<crypto_hash_t> &keys,
+    size_t count,
+    std::mt19937_64 &random)
+{
+    const auto value = random_bytes(random, LMDB_VALUE_SIZE);
+
+    while (keys.size() < count)
+    {
+        std::vector<crypto_hash_t> batch;
+
+        while (batch.size() < LMDB_FILL_BATCH && keys.size() + batch.size() < count)
+        {
+            batch.push_back(random_hash(random));
+        }
+
+    try_again:
+        auto txn = db->transaction();
+
+        for (const auto &key : batch)
+        {
+            auto error = txn->put(key, value);
+
+            MDB_CHECK_TXN_EXPAND(error, db->env(), txn, try_again);
+        }
+
+        auto error = txn->commit();
+
+        MDB_CHECK_TXN_EXPAND(error, db->env(), txn, try_again);
+
+        keys.insert(keys.end(), batch.begin(), batch.end());
+    }
+}
+
+template<typename Func> static void contend(size_t threads, Func &&func)
+{
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers.emplace_back(func, i);
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+template<typename T>
+static void benchmark_serialization(Utilities::BenchmarkSuite &suite, const T &value, const std::string &name)
+{
+    const auto bytes = value.serialize();
+
+    suite.run(
+        name + " serialize", [&value]() { [[maybe_unused]] const auto result = value.serialize(); }, 1'000, 10);
+
+    suite.run(
+        name + " deserialize", [&bytes]() { [[maybe_unused]] const auto result = T(bytes); }, 1'000, 10);
+}
+
+static void benchmark_containers(Utilities::BenchmarkSuite &suite)
+{
+    suite.print_header("Thread safe containers (" + std::to_string(CONTENTION_OPERATIONS) + " operations per thread)");
+
+    const auto max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        const auto suffix = " (" + std::to_string(threads) + " threads)";
+
+        suite.run(
+            "ThreadSafeMap insert/contains" + suffix,
+            [&threads]()
+            {
+                ThreadSafeMap<uint64_t, uint64_t> container;
+
+                contend(
+                    threads,
+                    [&container](size_t id)
+                    {
+                        for (uint64_t i = 0; i < CONTENTION_OPERATIONS; ++i)
+                        {
+                            container.insert_or_assign((id * CONTENTION_OPERATIONS + i) % 1'024, i);
+
+                            [[maybe_unused]] const auto found = container.contains(i % 1'024);
+                        }
+                    });
+            },
+            10);
+
+        suite.run(
+            "ThreadSafeSet insert/contains" + suffix,
+            [&threads]()
+            {
+                ThreadSafeSet<uint64_t> container;
+
+                contend(
+                    threads,
+                    [&container](size_t id)
+                    {
+                        for (uint64_t i = 0; i < CONTENTION_OPERATIONS; ++i)
+                        {
+                            container.insert((id * CONTENTION_OPERATIONS + i) % 1'024);
+
+                            [[maybe_unused]] const auto found = container.contains(i % 1'024);
+                        }
+                    });
+            },
+            10);
+
+        suite.run(
+            "ThreadSafeQueue push/pop" + suffix,
+            [&threads]()
+            {
+                ThreadSafeQueue<uint64_t> container;
+
+                // every pop is preceded by a push from the same thread so the queue is never empty
+                contend(
+                    threads,
+                    [&container](size_t id)
+                    {
+                        for (uint64_t i = 0; i < CONTENTION_OPERATIONS; ++i)
+                        {
+                            container.push(i);
+
+                            [[maybe_unused]] const auto item = container.pop();
+                        }
+                    });
+            },
+            10);
+
+        suite.run(
+            "ThreadSafeDeque push_back/pop_front" + suffix,
+            [&threads]()
+            {
+                ThreadSafeDeque<uint64_t> container;
+
+                contend(
+                    threads,
+                    [&container](size_t id)
+                    {
+                        for (uint64_t i = 0; i < CONTENTION_OPERATIONS; ++i)
+                        {
+                            container.push_back(i);
+
+                            [[maybe_unused]] const auto item = container.pop_front();
+                        }
+                    });
+            },
+            10);
+
+        suite.run(
+            "ThreadSafeBoundedQueue producer/consumer" + suffix,
+            [&threads]()
+            {
+                ThreadSafeBoundedQueue<uint64_t> container(Configuration::Node::PIPELINE_QUEUE_DEPTH);
+
+                // even workers produce and odd workers consume the same number of items
+                contend(
+                    threads * 2,
+                    [&container](size_t id)
+                    {
+                        for (uint64_t i = 0; i < CONTENTION_OPERATIONS; ++i)
+                        {
+                            if (id % 2 == 0)
+                            {
+                                container.push(i);
+                            }
+                            else
+                            {
+                                uint64_t item;
+
+                                container.pop(item);
+                            }
+                        }
+                    });
+            },
+            10);
+    }
+}
+
+static void benchmark_lmdb(Utilities::BenchmarkSuite &suite, const std::string &db_path)
+{
+    auto env = Database::LMDB::instance(db_path + "/lmdb", 0, 0600, 16, 8);
+
+    for (const size_t table_size : {1'000, 10'000, 100'000})
+    {
+        suite.print_header("LMDBDatabase (" + std::to_string(table_size) + " entries)");
+
+        auto db = env->open_database("table_" + std::to_string(table_size));
+
+        db->drop(false);
+
+        std::vector<crypto_hash_t> keys;
+
+        fill_database(db, keys, table_size, suite.random());
+
+        const auto value = random_bytes(suite.random(), LMDB_VALUE_SIZE);
+
+        const auto suffix = " @ " + std::to_string(table_size);
+
+        crypto_hash_t key;
+
+        suite.run(
+            "LMDBDatabase::put" + suffix,
+            [&db, &key, &value]()
+            {
+                serializer_t i_key;
+
+                key.serialize(i_key);
+
+                [[maybe_unused]] const auto error = db->put(i_key, value);
+            },
+            1'000,
+            1,
+            [&suite, &key]() { key = random_hash(suite.random()); });
+
+        suite.run(
+            "LMDBDatabase::get" + suffix,
+            [&db, &key]() { [[maybe_unused]] const auto [error, result] = db->get(key); },
+            1'000,
+            1,
+            [&suite, &key, &keys]() { key = keys[suite.random()() % keys.size()]; });
+
+        suite.run(
+            "LMDBCursor walk " + std::to_string(LMDB_CURSOR_WALK) + suffix,
+            [&db, &key]()
+            {
+                auto txn = db->transaction(true);
+
+                auto cursor = txn->cursor();
+
+                auto [error, i_key, i_value] = cursor->get(key, MDB_SET_RANGE);
+
+                for (size_t i = 0; i < LMDB_CURSOR_WALK && !error; ++i)
+                {
+                    std::tie(error, std::ignore, std::ignore) = cursor->get(MDB_NEXT);
+                }
+            },
+            1'000,
+            1,
+            [&suite, &key, &keys]() { key = keys[suite.random()() % keys.size()]; });
+
+        suite.run(
+            "LMDBDatabase::count" + suffix, [&db]() { [[maybe_unused]] const auto count = db->count(); }, 1'000, 10);
+
+        suite.run(
+            "LMDBIterator range " + std::to_string(LMDB_CURSOR_WALK) + suffix,
+            [&db, &key]()
+            {
+                Database::lmdb_iterator_options_t options;
+
+                options.start_key = key.serialize();
+
+                options.limit = LMDB_CURSOR_WALK;
+
+                for ([[maybe_unused]] const auto &entry : db->iterate(options)) {}
+            },
+            1'000,
+            1,
+            [&suite, &key, &keys]() { key = keys[suite.random()() % keys.size()]; });
+
+        suite.run(
+            "LMDBDatabase::get_all" + suffix,
+            [&db]() { [[maybe_unused]] const auto values = db->get_all(); },
+            10,
+            1);
+    }
+
+    suite.print_header("LMDBDatabase (sequential keys)");
+
+    const auto value = random_bytes(suite.random(), LMDB_VALUE_SIZE);
+
+    // block indexes are written in order, compare the B-tree search of a put with an append
+    for (const auto &[name, flags] : {std::make_pair("put", 0), std::make_pair("append", MDB_INTEGERKEY)})
+    {
+        auto db = env->open_database("sequential_" + std::string(name), flags);
+
+        db->drop(false);
+
+        uint64_t key = 0;
+
+        suite.run(
+            "LMDBTransaction::" + std::string(name) + " (sequential keys)",
+            [&db, &key, &value, flags = flags]()
+            {
+                auto txn = db->transaction();
+
+                for (size_t i = 0; i < LMDB_CURSOR_WALK; ++i, ++key)
+                {
+                    [[maybe_unused]] const auto error = (flags != 0) ? txn->append(key, value) : txn->put(key, value);
+                }
+
+                [[maybe_unused]] const auto error = txn->commit();
+            },
+            1'000,
+            1);
+    }
+}
+
+static void benchmark_serialization(Utilities::BenchmarkSuite &suite)
+{
+    suite.print_header("Serialization");
+
+    auto &random = suite.random();
+
+    Core::chain_generator_config_t config;
+
+    config.seed = suite.seed();
+
+    config.transactions_per_block = STORAGE_TRANSACTIONS_PER_BLOCK;
+
+    Core::ChainGenerator generator(config);
+
+    const auto [block, transactions] = generator.next_block();
+
+    benchmark_serialization(suite, block, "block_t");
+
+    genesis_transaction_t genesis;
+
+    genesis.public_key = random_key(random);
+
+    genesis.secret_key = Configuration::Transaction::Genesis::TX_PRIVATE_KEY;
+
+    for (size_t i = 0; i < Configuration::Transaction::RING_SIZE * 2; ++i)
+    {
+        genesis.outputs.emplace_back(random_key(random), 1 + random() % 1'000'000, random_key(random));
+    }
+
+    benchmark_serialization(suite, genesis, "genesis_transaction_t");
+
+    benchmark_serialization(suite, std::get<staker_transaction_t>(block.reward_tx), "staker_transaction_t");
+
+    const auto normal = generator.normal_transaction();
+
+    benchmark_serialization(suite, normal, "committed_normal_transaction_t");
+
+    const auto stake = generator.stake_transaction();
+
+    benchmark_serialization(suite, stake, "committed_stake_transaction_t");
+
+    // recalls the stake generated above
+    const auto recall = generator.recall_stake_transaction();
+
+    benchmark_serialization(suite, recall, "committed_recall_stake_transaction_t");
+
+    stake_refund_transaction_t refund;
+
+    refund.public_key = random_key(random);
+
+    refund.recall_stake_tx = random_hash(random);
+
+    refund.outputs = normal.outputs;
+
+    benchmark_serialization(suite, refund, "stake_refund_transaction_t");
+
+    uncommited_normal_transaction_t uncommitted;
+
+    uncommitted.public_key = normal.public_key;
+
+    uncommitted.key_images = normal.key_images;
+
+    uncommitted.outputs = normal.outputs;
+
+    for (size_t i = 0; i < Configuration::Transaction::RING_SIZE; ++i)
+    {
+        uncommitted.ring_participants.push_back(random_hash(random));
+    }
+
+    benchmark_serialization(suite, uncommitted, "uncommited_normal_transaction_t");
+}
+
+static void benchmark_storage(Utilities::BenchmarkSuite &suite, const std::string &db_path)
+{
+    suite.print_header(
+        "BlockchainStorage (" + std::to_string(STORAGE_BLOCKS) + " blocks of "
+        + std::to_string(STORAGE_TRANSACTIONS_PER_BLOCK) + " transactions)");
+
+    auto storage = Core::BlockchainStorage::instance(db_path + "/chain");
+
+    auto &random = suite.random();
+
+    Core::chain_generator_config_t config;
+
+    config.seed = suite.seed();
+
+    config.transactions_per_block = STORAGE_TRANSACTIONS_PER_BLOCK;
+
+    Core::ChainGenerator generator(config);
+
+    block_t block;
+
+    std::vector<transaction_t> transactions;
+
+    suite.run(
+        "BlockchainStorage::put_block",
+        [&]() { abort_on_error("BlockchainStorage::put_block", storage->put_block(block, transactions)); },
+        STORAGE_BLOCKS,
+        1,
+        [&]() { std::tie(block, transactions) = generator.next_block(); });
+
+    // the warm up stored a block too, so the index of the next block is the number of blocks stored
+    const auto block_index = generator.block_index();
+
+    suite.run(
+        "BlockchainStorage::get_block",
+        [&]() { [[maybe_unused]] const auto [error, result, txns] = storage->get_block(random() % block_index); },
+        1'000);
+
+    for (const size_t count : {size_t(16), Configuration::Transaction::RING_SIZE})
+    {
+        suite.run(
+            "BlockchainStorage::get_random_outputs (" + std::to_string(count) + ")",
+            [&]() { [[maybe_unused]] const auto [error, outputs] = storage->get_random_outputs(0, count); },
+            100);
+    }
+}
+
+static void benchmark_validator(Utilities::BenchmarkSuite &suite, const std::string &db_path)
+{
+    suite.print_header("TransactionValidator (" + std::to_string(VALIDATOR_TRANSACTIONS) + " transactions)");
+
+    auto storage = Core::BlockchainStorage::instance(db_path + "/chain");
+
+    auto staking_engine = Core::StakingEngine::instance(db_path + "/staking");
+
+    const auto validator = Core::TransactionValidator(storage, staking_engine);
+
+    // a different seed keeps the key images clear of those already written by the storage benchmarks
+    Core::chain_generator_config_t config;
+
+    config.seed = suite.seed() + 1;
+
+    config.mine = true;
+
+    Core::ChainGenerator generator(config);
+
+    // the proof of work of each transaction is checked every time so only a few are needed
+    std::vector<transaction_t> transactions;
+
+    for (size_t i = 0; i < VALIDATOR_TRANSACTIONS; ++i)
+    {
+        transactions.emplace_back(generator.normal_transaction());
+    }
+
+    const auto block_index = storage->get_block_count();
+
+    size_t next = 0;
+
+    suite.run(
+        "TransactionValidator::check",
+        [&]()
+        {
+            abort_on_error(
+                "TransactionValidator::check", validator.check(transactions[next++ % transactions.size()]));
+        },
+        VALIDATOR_ITERATIONS);
+
+    suite.run(
+        "TransactionValidator::validate",
+        [&]()
+        {
+            abort_on_error(
+                "TransactionValidator::validate",
+                validator.validate(block_index, transactions[next++ % transactions.size()]));
+        },
+        VALIDATOR_ITERATIONS);
+
+    suite.run(
+        "TransactionValidator::validate (block)",
+        [&]()
+        { abort_on_error("TransactionValidator::validate (block)", validator.validate(block_index, transactions)); },
+        VALIDATOR_ITERATIONS);
+}
+
+int main(int argc, char **argv)
+{
+    auto cli = std::make_shared<Utilities::CLIHelper>(argv);
+
+    std::string db_path = "./benchmark-data", json_path;
+
+    uint64_t seed = Utilities::BenchmarkSuite::DEFAULT_SEED;
+
+    // clang-format off
+    cli->add_options("Benchmark")
+        ("db-path", "The directory to create the benchmark databases in (removed before the run)",
+         cxxopts::value<std::string>(db_path)->default_value(db_path))
+        ("json", "Write the results to the specified file as JSON",
+         cxxopts::value<std::string>(json_path))
+        ("seed", "The seed used to generate the benchmark data",
+         cxxopts::value<uint64_t>(seed)->default_value(std::to_string(seed)));
+    // clang-format on
+
+    cli->parse(argc, argv);
+
+    // the results are only comparable between runs if each run starts with empty databases
+    {
+        auto directory = cppfs::fs::open(db_path);
+
+        if (directory.isDirectory())
+        {
+            directory.removeDirectoryRec();
+        }
+
+        directory.createDirectory();
+    }
+
+    Utilities::BenchmarkSuite suite("turtlecoin", seed);
+
+    benchmark_serialization(suite);
+
+    benchmark_containers(suite);
+
+    benchmark_lmdb(suite, db_path);
+
+    benchmark_storage(suite, db_path);
+
+    benchmark_validator(suite, db_path);
+
+    std::cout << std::endl;
+
+    if (!json_path.empty())
+    {
+        if (!suite.save_json(json_path))
+        {
+            std::cout << "Could not write the results to: " << json_path << std::endl;
+
+            return 1;
+        }
+
+        std::cout << "Results written to: " << json_path << std::endl;
+    }
+
+    return 0;
+}
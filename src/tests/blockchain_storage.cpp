@@ -0,0 +1,91 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include <blockchain_storage.h>
+#include <chain_generator.h>
+#include <cli_helper.h>
+#include <cppfs/FileHandle.h>
+#include <cppfs/fs.h>
+#include <logger.h>
+
+int main(int argc, char **argv)
+{
+    auto cli = std::make_shared<Utilities::CLIHelper>(argv);
+
+    std::string db_path = "./blockchain-storage-test-data";
+
+    cli->parse(argc, argv);
+
+    auto logger = Logger::create_logger("", cli->log_level());
+
+    // every run starts with an empty database
+    {
+        auto directory = cppfs::fs::open(db_path);
+
+        if (directory.isDirectory())
+        {
+            directory.removeDirectoryRec();
+        }
+
+        directory.createDirectory();
+    }
+
+    auto storage = Core::BlockchainStorage::instance(db_path + "/chain");
+
+    logger->warn("Blocks Without Transactions Check");
+
+    Core::chain_generator_config_t config;
+
+    // the genesis block and empty producer blocks carry only the block reward transaction
+    config.transactions_per_block = 0;
+
+    Core::ChainGenerator generator(config);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const auto [block, transactions] = generator.next_block();
+
+        if (const auto error = storage->put_block(block, transactions))
+        {
+            logger->error("Store block {0} without transactions... Failed: {1}", i, error.to_string());
+
+            exit(1);
+        }
+
+        logger->info("Store block {0} without transactions... Passed", i);
+
+        const auto [error, stored_block, stored_transactions] = storage->get_block(block.block_index);
+
+        if (error || stored_block.hash() != block.hash() || !stored_transactions.empty())
+        {
+            logger->error("Read back block {0} without transactions... Failed", i);
+
+            exit(1);
+        }
+
+        const auto reward_hash = std::visit([](auto &&arg) { return arg.hash(); }, block.reward_tx);
+
+        const auto stored_reward_hash = std::visit([](auto &&arg) { return arg.hash(); }, stored_block.reward_tx);
+
+        if (reward_hash != stored_reward_hash)
+        {
+            logger->error("Read back the block reward of block {0}... Failed", i);
+
+            exit(1);
+        }
+
+        logger->info("Read back block {0} without transactions... Passed", i);
+    }
+
+    if (storage->get_block_count() != 3)
+    {
+        logger->error("Block count after storing blocks without transactions... Failed");
+
+        exit(1);
+    }
+
+    logger->info("Block count after storing blocks without transactions... Passed");
+
+    return 0;
+}
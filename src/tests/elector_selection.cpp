@@ -0,0 +1,151 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include <cli_helper.h>
+#include <config.h>
+#include <crypto.h>
+#include <elector_selection.h>
+#include <logger.h>
+#include <set>
+
+static crypto_hash_t make_seed(uint64_t value)
+{
+    serializer_t writer;
+
+    writer.varint(value);
+
+    return Crypto::Hashing::sha3(writer.data(), writer.size());
+}
+
+static bool has_duplicates(const std::vector<crypto_public_key_t> &electors)
+{
+    return std::set<crypto_public_key_t>(electors.begin(), electors.end()).size() != electors.size();
+}
+
+int main(int argc, char **argv)
+{
+    auto cli = std::make_shared<Utilities::CLIHelper>(argv);
+
+    cli->parse(argc, argv);
+
+    auto logger = Logger::create_logger("", cli->log_level());
+
+    const auto permanent = Configuration::Consensus::PERMANENT_CANDIDATES.size();
+
+    // a couple of candidates hold nearly all of the stake and the rest share what is left equally
+    std::vector<std::tuple<crypto_public_key_t, uint64_t>> candidates;
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        candidates.emplace_back(Crypto::random_point(), 1'000'000'000'000);
+    }
+
+    for (size_t i = 0; i < 50; ++i)
+    {
+        candidates.emplace_back(Crypto::random_point(), 1'000);
+    }
+
+    Core::ElectorSelection selection, reversed;
+
+    for (const auto &[candidate, weight] : candidates)
+    {
+        selection.set_weight(candidate, weight);
+    }
+
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it)
+    {
+        reversed.set_weight(std::get<0>(*it), std::get<1>(*it));
+    }
+
+    const auto count = permanent + 5;
+
+    logger->warn("Elector Selection Checks");
+
+    {
+        const auto [producers, validators] = selection.elect(make_seed(0), count, count);
+
+        const auto [other_producers, other_validators] = reversed.elect(make_seed(0), count, count);
+
+        if (producers != other_producers || validators != other_validators)
+        {
+            logger->error("Same seed elects the same electors... Failed");
+
+            exit(1);
+        }
+
+        logger->info("Same seed elects the same electors... Passed");
+
+        const auto [seeded_producers, seeded_validators] = selection.elect(make_seed(1), count, count);
+
+        if (producers == seeded_producers && validators == seeded_validators)
+        {
+            logger->error("Different seeds elect different electors... Failed");
+
+            exit(1);
+        }
+
+        logger->info("Different seeds elect different electors... Passed");
+    }
+
+    // the seat after the two large candidates must be drawn by stake, not taken in key order
+    std::set<crypto_public_key_t> last_seats;
+
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        const auto [producers, validators] = selection.elect(make_seed(i), count, count);
+
+        if (producers.size() != count || validators.size() != count || has_duplicates(producers)
+            || has_duplicates(validators))
+        {
+            logger->error("Electors are drawn without replacement... Failed");
+
+            exit(1);
+        }
+
+        for (size_t j = 0; j < 2; ++j)
+        {
+            const auto &candidate = std::get<0>(candidates[j]);
+
+            if (std::find(producers.begin(), producers.end(), candidate) == producers.end()
+                || std::find(validators.begin(), validators.end(), candidate) == validators.end())
+            {
+                logger->error("Candidates holding most of the stake are elected... Failed");
+
+                exit(1);
+            }
+        }
+
+        last_seats.insert(producers.back());
+    }
+
+    logger->info("Electors are drawn without replacement... Passed");
+
+    logger->info("Candidates holding most of the stake are elected... Passed");
+
+    if (last_seats.size() < 2)
+    {
+        logger->error("Remaining seats are drawn by stake... Failed");
+
+        exit(1);
+    }
+
+    logger->info("Remaining seats are drawn by stake... Passed");
+
+    {
+        const auto [producers, validators] =
+            selection.elect(make_seed(0), permanent + candidates.size() + 10, permanent + candidates.size() + 10);
+
+        if (producers.size() != permanent + candidates.size() || has_duplicates(producers)
+            || validators.size() != permanent + candidates.size() || has_duplicates(validators))
+        {
+            logger->error("Every candidate is elected once when seats exceed candidates... Failed");
+
+            exit(1);
+        }
+
+        logger->info("Every candidate is elected once when seats exceed candidates... Passed");
+    }
+
+    return 0;
+}
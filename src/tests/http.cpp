@@ -5,6 +5,7 @@
 #include <cli_helper.h>
 #include <console.h>
 #include <http_client.h>
+#include <http_client_pool.h>
 #include <http_server.h>
 #include <ring_signature_clsag.h>
 
@@ -21,6 +22,8 @@ int main(int argc, char **argv)
 
     size_t server_timeout = 30;
 
+    http_server_options_t server_options;
+
     // clang-format off
     cli->add_options("Server")
         ("p,port", "The local port to bind the server to",
@@ -29,13 +32,15 @@ int main(int argc, char **argv)
          cxxopts::value<size_t>(server_timeout)->default_value(std::to_string(server_timeout)));
     // clang-format on
 
+    HTTPServer::add_options(*cli, server_options);
+
     cli->parse(argc, argv);
 
     console->catch_abort();
 
     auto logger = Logger::create_logger("./test-http.log", cli->log_level());
 
-    auto server = std::make_shared<HTTPServer>(logger);
+    auto server = std::make_shared<HTTPServer>(logger, "*", server_options);
 
     server->Get(
         "/",
@@ -52,6 +57,26 @@ int main(int argc, char **argv)
             return response.set_content(result, "application/json");
         });
 
+    server->Get(
+        "/cached",
+        [&server](const auto &request, auto &response)
+        {
+            if (server->response_cache()->get(request, response, "cached", "json"))
+            {
+                return;
+            }
+
+            server->response_cache()->put(
+                request, response, "cached", "json", 0, "{\"cached\":true}", "application/json");
+        });
+
+    const auto compressible = "[" + std::string(Configuration::API::HTTP_COMPRESSION_THRESHOLD * 4, '0') + "]";
+
+    server->Get(
+        "/compressed",
+        [&compressible](const auto &request, auto &response)
+        { response.set_content(compressible, "application/json"); });
+
     logger->info("HTTP Test server starting...");
 
     if (!server->listen("0.0.0.0", server_port))
@@ -87,6 +112,113 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    {
+        const auto first = client->Get("/cached");
+
+        if (!first || first->status != 200 || !first->has_header("ETag"))
+        {
+            logger->error("Client did not receive a cacheable response from the server");
+
+            exit(1);
+        }
+
+        const auto etag = first->get_header_value("ETag");
+
+        // the second request is served from the cache and the client already holds the body
+        const auto second = client->Get("/cached", {{"If-None-Match", etag}});
+
+        if (!second || second->status != 304 || !second->body.empty())
+        {
+            logger->error("Client did not receive a 304 for a cached response with a matching ETag");
+
+            exit(1);
+        }
+
+        if (server->response_cache()->hits() != 1)
+        {
+            logger->error("The cached response was not served from the response cache");
+
+            exit(1);
+        }
+
+        // the resource belongs to block 0 so a rewind to block 0 must keep it
+        server->response_cache()->rewind(0);
+
+        if (server->response_cache()->count() != 1)
+        {
+            logger->error("The response cache dropped an entry at the rewind height");
+
+            exit(1);
+        }
+
+        server->response_cache()->clear();
+
+        logger->info("Client received cached responses with ETag: {}", etag);
+    }
+
+    {
+        const auto identity = client->Get("/compressed");
+
+        const auto compressed = client->Get("/compressed", {{"Accept-Encoding", "br;q=1.0, gzip;q=0.8, *;q=0.1"}});
+
+        if (!identity || !compressed || identity->body != compressible || identity->has_header("Content-Encoding"))
+        {
+            logger->error("Client did not receive an uncompressed response without an Accept-Encoding");
+
+            exit(1);
+        }
+
+#ifdef HTTP_COMPRESSION
+        if (compressed->get_header_value("Content-Encoding") != "gzip"
+            || compressed->body.size() >= compressible.size())
+        {
+            logger->error("Client did not receive a gzip compressed response");
+
+            exit(1);
+        }
+
+        // the wildcard does not override a coding that the client refuses
+        if (HTTPCompressor::negotiate("gzip;q=0, *") != HTTP_ENCODING_DEFLATE)
+        {
+            logger->error("Negotiation selected an encoding that the client refused");
+
+            exit(1);
+        }
+#endif
+
+        logger->info(
+            "Client received a {} byte response in {} bytes with Accept-Encoding",
+            compressible.size(),
+            compressed->body.size());
+    }
+
+    {
+        auto pool = HTTPClientPool::instance("127.0.0.1", server_port);
+
+        const auto responses = pool->get(std::vector<std::string>(16, "/"));
+
+        for (const auto &response : responses)
+        {
+            if (!response || response->status != 200)
+            {
+                logger->error("Pooled client did not receive a valid response from the server");
+
+                exit(1);
+            }
+        }
+
+        // every connection opened by the batch is held open for reuse
+        if (pool->active() != 0 || pool->idle() == 0
+            || pool->idle() > Configuration::API::HTTP_CLIENT_MAXIMUM_CONNECTIONS)
+        {
+            logger->error("Pooled clients were not returned to the pool");
+
+            exit(1);
+        }
+
+        logger->info("Pooled clients received {} responses over {} connections", responses.size(), pool->idle());
+    }
+
     logger->info("HTTP Test Server Started");
 
     console->run();
@@ -0,0 +1,540 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+/**
+ * Replays a chain through the same steps that the node takes to import a block and
+ * reports the time spent in each step per block so that the step that dominates the
+ * import on a particular machine can be identified
+ *
+ * The chain is either generated (see Core::ChainGenerator) or read from an existing
+ * blockchain database and is encoded as block data packet payloads up front so that
+ * the deserialization is measured against the same bytes the node receives. Each
+ * block is then decoded, hashed, has its proof of work verified (if requested), is
+ * checked and validated by the transaction validator, and is written with put_block
+ * into an empty database whose write is broken down further into its own phases.
+ *
+ * Committed transactions carry only the hashes of their ring signatures and range
+ * proofs, which are verified (along with the ring members they reference) when the
+ * transaction enters the pool, so those costs are not part of importing a block.
+ */
+
+#include <algorithm>
+#include <array>
+#include <blockchain_storage.h>
+#include <chain_generator.h>
+#include <cli_helper.h>
+#include <config.h>
+#include <cppfs/FileHandle.h>
+#include <cppfs/fs.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <staking_engine.h>
+#include <transaction_validator.h>
+#include <types.h>
+
+#define PHASE_NAME_WIDTH 24
+#define PHASE_COLUMN_WIDTH 14
+
+using namespace Types::Blockchain;
+
+enum import_phase_t
+{
+    PHASE_DESERIALIZE,
+    PHASE_HASH,
+    PHASE_POW,
+    PHASE_CHECK,
+    PHASE_VALIDATE,
+    PHASE_PREPARE,
+    PHASE_WRITE,
+    PHASE_COMMIT,
+    PHASE_EXPAND,
+    PHASE_TOTAL,
+    PHASE_COUNT
+};
+
+static const std::vector<std::string> PHASE_NAMES = {
+    "deserialize",
+    "hash",
+    "proof of work",
+    "check",
+    "validate (key images)",
+    "write preparation",
+    "LMDB writes",
+    "commit",
+    "map expansion",
+    "total"};
+
+typedef std::array<double, PHASE_COUNT> block_timings_t;
+
+static inline double elapsed_microseconds(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+static inline double to_microseconds(const std::chrono::nanoseconds &duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static inline double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    return sorted[static_cast<size_t>((sorted.size() - 1) * p)];
+}
+
+/**
+ * Encodes the block in the same format as the payload of a block data packet
+ */
+static std::vector<uint8_t> encode(const block_t &block, const std::vector<transaction_t> &transactions)
+{
+    serializer_t writer;
+
+    block.serialize(writer);
+
+    writer.varint(transactions.size());
+
+    for (const auto &transaction : transactions)
+    {
+        std::visit([&writer](auto &&arg) { arg.serialize(writer); }, transaction);
+    }
+
+    return writer.vector();
+}
+
+/**
+ * Decodes a block data packet payload in the same way as the decode stage of the node pipeline
+ */
+static Error decode(const std::vector<uint8_t> &payload, block_t &block, std::vector<transaction_t> &transactions)
+{
+    try
+    {
+        deserializer_t reader(payload);
+
+        block = block_t(reader);
+
+        const auto count = reader.varint<uint64_t>();
+
+        if (count != block.transactions.size())
+        {
+            return MAKE_ERROR(BLOCK_TXN_MISMATCH);
+        }
+
+        transactions.clear();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            // figure out what type of transaction it is
+            const auto type = reader.varint<uint64_t>(true);
+
+            switch (type)
+            {
+                case TransactionType::GENESIS:
+                    transactions.emplace_back(genesis_transaction_t(reader));
+                    break;
+                case TransactionType::STAKER:
+                    transactions.emplace_back(staker_transaction_t(reader));
+                    break;
+                case TransactionType::NORMAL:
+                    transactions.emplace_back(committed_normal_transaction_t(reader));
+                    break;
+                case TransactionType::STAKE:
+                    transactions.emplace_back(committed_stake_transaction_t(reader));
+                    break;
+                case TransactionType::RECALL_STAKE:
+                    transactions.emplace_back(committed_recall_stake_transaction_t(reader));
+                    break;
+                case TransactionType::STAKE_REFUND:
+                    transactions.emplace_back(stake_refund_transaction_t(reader));
+                    break;
+                default:
+                    return MAKE_ERROR(UNKNOWN_TRANSACTION_TYPE);
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        return MAKE_ERROR_MSG(BLOCK_DECODE, e.what());
+    }
+
+    return MAKE_ERROR(SUCCESS);
+}
+
+/**
+ * Loads the payloads of the requested number of blocks from an existing blockchain database
+ */
+static Error load_chain(const std::string &source_path, uint64_t height, std::vector<std::vector<uint8_t>> &payloads)
+{
+    auto source = Core::BlockchainStorage::instance(source_path);
+
+    height = std::min<uint64_t>(height, source->get_block_count());
+
+    for (uint64_t i = 0; i < height; ++i)
+    {
+        const auto [error, block, transactions] = source->get_block(i);
+
+        if (error)
+        {
+            return error;
+        }
+
+        payloads.push_back(encode(block, transactions));
+    }
+
+    return MAKE_ERROR(SUCCESS);
+}
+
+static void print_report(const std::vector<block_timings_t> &timings, double elapsed_seconds, size_t transactions)
+{
+    std::cout << std::endl
+              << "Imported " << timings.size() << " blocks (" << transactions << " transactions) in " << std::fixed
+              << std::setprecision(2) << elapsed_seconds << "s: " << timings.size() / elapsed_seconds
+              << " blocks/s, " << transactions / elapsed_seconds << " transactions/s" << std::endl
+              << std::endl;
+
+    std::cout << std::setw(PHASE_NAME_WIDTH) << std::left << "Phase (per block)" << std::setw(PHASE_COLUMN_WIDTH)
+              << std::right << "Mean (us)" << std::setw(PHASE_COLUMN_WIDTH) << "p50 (us)"
+              << std::setw(PHASE_COLUMN_WIDTH) << "p99 (us)" << std::setw(PHASE_COLUMN_WIDTH) << "Share" << std::endl;
+
+    std::cout << std::string(PHASE_NAME_WIDTH + PHASE_COLUMN_WIDTH * 4, '-') << std::endl;
+
+    double total_time = 0;
+
+    for (const auto &block : timings)
+    {
+        total_time += block[PHASE_TOTAL];
+    }
+
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        std::vector<double> samples;
+
+        samples.reserve(timings.size());
+
+        double sum = 0;
+
+        for (const auto &block : timings)
+        {
+            samples.push_back(block[phase]);
+
+            sum += block[phase];
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        if (phase == PHASE_TOTAL)
+        {
+            std::cout << std::string(PHASE_NAME_WIDTH + PHASE_COLUMN_WIDTH * 4, '-') << std::endl;
+        }
+
+        std::cout << std::setw(PHASE_NAME_WIDTH) << std::left << PHASE_NAMES[phase] << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(PHASE_COLUMN_WIDTH) << sum / samples.size()
+                  << std::setw(PHASE_COLUMN_WIDTH) << percentile(samples, 0.50) << std::setw(PHASE_COLUMN_WIDTH)
+                  << percentile(samples, 0.99) << std::setw(PHASE_COLUMN_WIDTH - 1)
+                  << (total_time > 0 ? 100 * sum / total_time : 0) << "%" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+static bool save_json(const std::string &path, const std::vector<block_timings_t> &timings)
+{
+    JSON_INIT_BUFFER(buffer, writer);
+
+    writer.StartObject();
+    {
+        writer.Key("time_unit");
+        writer.String("us");
+
+        writer.Key("phases");
+        writer.StartArray();
+        {
+            for (const auto &name : PHASE_NAMES)
+            {
+                writer.String(name);
+            }
+        }
+        writer.EndArray();
+
+        // the raw timings of every block so that other statistics may be derived later
+        writer.Key("blocks");
+        writer.StartArray();
+        {
+            for (const auto &block : timings)
+            {
+                writer.StartArray();
+                {
+                    for (const auto &value : block)
+                    {
+                        writer.Double(value);
+                    }
+                }
+                writer.EndArray();
+            }
+        }
+        writer.EndArray();
+    }
+    writer.EndObject();
+
+    JSON_DUMP_BUFFER(buffer, result);
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    file << result << std::endl;
+
+    return file.good();
+}
+
+int main(int argc, char **argv)
+{
+    auto cli = std::make_shared<Utilities::CLIHelper>(argv);
+
+    Core::chain_generator_config_t config;
+
+    uint64_t height = 1'000;
+
+    bool verify_pow = false;
+
+    std::string db_path = "./import-benchmark-data", source_path, json_path;
+
+    // clang-format off
+    cli->add_options("Import Benchmark")
+        ("db-path", "The directory to import the chain into (removed before the run)",
+         cxxopts::value<std::string>(db_path)->default_value(db_path))
+        ("height", "The number of blocks to import",
+         cxxopts::value<uint64_t>(height)->default_value(std::to_string(height)))
+        ("json", "Write the timings of every block to the specified file as JSON",
+         cxxopts::value<std::string>(json_path))
+        ("seed", "The seed used to generate the synthetic chain",
+         cxxopts::value<uint64_t>(config.seed)->default_value(std::to_string(config.seed)))
+        ("source", "Replay the chain in the specified blockchain database instead of a synthetic chain",
+         cxxopts::value<std::string>(source_path))
+        ("transactions", "The number of transactions in each block of the synthetic chain",
+         cxxopts::value<size_t>(config.transactions_per_block)
+            ->default_value(std::to_string(config.transactions_per_block)))
+        ("verify-pow", "Verify the proof of work of every transaction (approximately one second per transaction)",
+         cxxopts::value<bool>(verify_pow)->implicit_value("true"));
+    // clang-format on
+
+    cli->parse(argc, argv);
+
+    // the import must always start from an empty database for the results to be comparable
+    {
+        auto directory = cppfs::fs::open(db_path);
+
+        if (directory.isDirectory())
+        {
+            directory.removeDirectoryRec();
+        }
+
+        directory.createDirectory();
+    }
+
+    std::vector<std::vector<uint8_t>> payloads;
+
+    if (!source_path.empty())
+    {
+        std::cout << "Loading " << height << " blocks from: " << source_path << std::endl;
+
+        const auto error = load_chain(source_path, height, payloads);
+
+        if (error)
+        {
+            std::cout << "Could not load the chain: " << error.to_string() << std::endl;
+
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << "Generating " << height << " blocks of " << config.transactions_per_block
+                  << " transactions with seed " << config.seed << std::endl;
+
+        Core::ChainGenerator generator(config);
+
+        for (uint64_t i = 0; i < height; ++i)
+        {
+            const auto [block, transactions] = generator.next_block();
+
+            payloads.push_back(encode(block, transactions));
+        }
+    }
+
+    if (payloads.empty())
+    {
+        std::cout << "There are no blocks to import" << std::endl;
+
+        return 1;
+    }
+
+    auto storage = Core::BlockchainStorage::instance(db_path + "/chain");
+
+    auto staking_engine = Core::StakingEngine::instance(db_path + "/staking");
+
+    auto validator = Core::TransactionValidator(storage, staking_engine);
+
+    /**
+     * The proof of work is timed on its own (and only when requested as it dwarfs everything
+     * else), so the checkpoint is placed just past the end of the replayed chain to keep the
+     * validator from verifying it, which is the same as a node syncing below its checkpoint
+     */
+    {
+        block_t last_block;
+
+        std::vector<transaction_t> last_transactions;
+
+        const auto error = decode(payloads.back(), last_block, last_transactions);
+
+        if (error)
+        {
+            std::cout << "Could not decode the last block: " << error.to_string() << std::endl;
+
+            return 1;
+        }
+
+        validator.set_assume_valid(last_block.hash(), last_block.block_index + 1);
+    }
+
+    std::vector<block_timings_t> timings;
+
+    timings.reserve(payloads.size());
+
+    size_t transaction_count = 0;
+
+    const auto import_start = std::chrono::steady_clock::now();
+
+    for (const auto &payload : payloads)
+    {
+        block_timings_t block_timings {};
+
+        const auto block_start = std::chrono::steady_clock::now();
+
+        block_t block;
+
+        std::vector<transaction_t> transactions;
+
+        auto error = decode(payload, block, transactions);
+
+        block_timings[PHASE_DESERIALIZE] = elapsed_microseconds(block_start);
+
+        if (!error)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            [[maybe_unused]] const auto block_hash = block.hash();
+
+            for (const auto &transaction : transactions)
+            {
+                [[maybe_unused]] const auto txn_hash = std::visit([](auto &&arg) { return arg.hash(); }, transaction);
+            }
+
+            block_timings[PHASE_HASH] = elapsed_microseconds(start);
+        }
+
+        if (!error && verify_pow)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            // synthetic chains are not mined, but rejecting the proof of work costs the same as accepting it
+            for (const auto &transaction : transactions)
+            {
+                std::visit(
+                    [](auto &&arg)
+                    {
+                        USEVARIANT(T, arg);
+
+                        if COMMITED_USER_TX_VARIANT (T)
+                        {
+                            [[maybe_unused]] const auto valid =
+                                arg.pow_verify(Configuration::Transaction::Fees::MINIMUM_POW_ZEROS);
+                        }
+                    },
+                    transaction);
+            }
+
+            block_timings[PHASE_POW] = elapsed_microseconds(start);
+        }
+
+        if (!error)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            for (const auto &transaction : transactions)
+            {
+                error = validator.check(transaction, true);
+
+                if (error)
+                {
+                    break;
+                }
+            }
+
+            block_timings[PHASE_CHECK] = elapsed_microseconds(start);
+        }
+
+        if (!error)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            error = validator.validate(block.block_index, transactions);
+
+            block_timings[PHASE_VALIDATE] = elapsed_microseconds(start);
+        }
+
+        if (!error)
+        {
+            Core::put_block_timings_t put_timings;
+
+            error = storage->put_block(block, transactions, put_timings);
+
+            block_timings[PHASE_PREPARE] = to_microseconds(put_timings.preparation);
+
+            block_timings[PHASE_WRITE] = to_microseconds(put_timings.writes);
+
+            block_timings[PHASE_COMMIT] = to_microseconds(put_timings.commit);
+
+            block_timings[PHASE_EXPAND] = to_microseconds(put_timings.expansion);
+        }
+
+        block_timings[PHASE_TOTAL] = elapsed_microseconds(block_start);
+
+        if (error)
+        {
+            std::cout << "Could not import block " << timings.size() << ": " << error.to_string() << std::endl;
+
+            return 1;
+        }
+
+        transaction_count += transactions.size();
+
+        timings.push_back(block_timings);
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - import_start).count();
+
+    print_report(timings, elapsed, transaction_count);
+
+    if (!json_path.empty())
+    {
+        if (!save_json(json_path, timings))
+        {
+            std::cout << "Could not write the results to: " << json_path << std::endl;
+
+            return 1;
+        }
+
+        std::cout << "Results written to: " << json_path << std::endl;
+    }
+
+    return 0;
+}
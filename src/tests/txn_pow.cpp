@@ -5,9 +5,12 @@
 #include <benchmark.h>
 #include <cli_helper.h>
 #include <config.h>
+#include <iostream>
+#include <pow_miner.h>
 #include <types.h>
 
 #define POW_TEST_ITERATIONS 10
+#define POW_SCALING_ZEROS 4
 
 int main(int argc, char **argv)
 {
@@ -34,5 +37,29 @@ int main(int argc, char **argv)
             25);
     }
 
+    std::cout << std::endl;
+
+    benchmark_header(40, 25);
+
+    const auto max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        benchmark(
+            [&threads]()
+            {
+                Types::Blockchain::uncommited_normal_transaction_t tx;
+
+                tx.public_key = Crypto::random_point();
+
+                [[maybe_unused]] const auto success =
+                    Common::ProofOfWork::mine_transaction(tx, POW_SCALING_ZEROS, threads);
+            },
+            "Mining " + std::to_string(POW_SCALING_ZEROS) + " zeros with " + std::to_string(threads) + " threads",
+            POW_TEST_ITERATIONS,
+            40,
+            25);
+    }
+
     return 0;
 }
@@ -0,0 +1,61 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include <cli_helper.h>
+#include <crypto.h>
+#include <logger.h>
+#include <verified_cache.h>
+
+int main(int argc, char **argv)
+{
+    auto cli = std::make_shared<Utilities::CLIHelper>(argv);
+
+    cli->parse(argc, argv);
+
+    auto logger = Logger::create_logger("", cli->log_level());
+
+    logger->warn("Verified Cache Rewind Check");
+
+    Core::VerifiedCache cache;
+
+    const auto below = Crypto::random_hash(), at = Crypto::random_hash(), above = Crypto::random_hash();
+
+    cache.add(below, 5);
+
+    cache.add(at, 8);
+
+    cache.add(above, 10);
+
+    // the chain is rewound to block 7, so the transactions verified for block 8 onwards are dropped
+    cache.rewind(8);
+
+    if (!cache.contains(below))
+    {
+        logger->error("Entry below the rewind height was kept... Failed");
+
+        exit(1);
+    }
+
+    logger->info("Entry below the rewind height was kept... Passed");
+
+    if (cache.contains(at) || cache.contains(above))
+    {
+        logger->error("Entries at and above the rewind height were dropped... Failed");
+
+        exit(1);
+    }
+
+    logger->info("Entries at and above the rewind height were dropped... Passed");
+
+    if (cache.size() != 1)
+    {
+        logger->error("Cache size after rewind... Failed");
+
+        exit(1);
+    }
+
+    logger->info("Cache size after rewind... Passed");
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "benchmark_suite.h"
+
+#include <algorithm>
+#include <config.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#define BENCHMARK_NAME_WIDTH 50
+#define BENCHMARK_COLUMN_WIDTH 14
+
+static inline double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    return sorted[static_cast<size_t>((sorted.size() - 1) * p)];
+}
+
+namespace Utilities
+{
+    BenchmarkSuite::BenchmarkSuite(std::string name, uint64_t seed):
+        m_name(std::move(name)), m_seed(seed), m_random(seed)
+    {
+        add_context("seed", std::to_string(seed));
+
+        add_context("threads", std::to_string(std::thread::hardware_concurrency()));
+
+        add_context(
+            "version",
+            std::to_string(Configuration::Version::MAJOR) + "." + std::to_string(Configuration::Version::MINOR) + "."
+                + std::to_string(Configuration::Version::PATCH) + "."
+                + std::to_string(Configuration::Version::BUILD));
+    }
+
+    void BenchmarkSuite::add_context(const std::string &key, const std::string &value)
+    {
+        m_context.emplace_back(key, value);
+    }
+
+    void BenchmarkSuite::print_header(const std::string &section) const
+    {
+        std::cout << std::endl << section << std::endl << std::endl;
+
+        std::cout << std::setw(BENCHMARK_NAME_WIDTH) << std::left << "Benchmark" << std::setw(BENCHMARK_COLUMN_WIDTH)
+                  << std::right << "Iterations" << std::setw(BENCHMARK_COLUMN_WIDTH) << "Mean (ns)"
+                  << std::setw(BENCHMARK_COLUMN_WIDTH) << "p50 (ns)" << std::setw(BENCHMARK_COLUMN_WIDTH)
+                  << "p99 (ns)" << std::endl;
+
+        std::cout << std::string(BENCHMARK_NAME_WIDTH + BENCHMARK_COLUMN_WIDTH * 4, '-') << std::endl;
+    }
+
+    std::mt19937_64 &BenchmarkSuite::random()
+    {
+        return m_random;
+    }
+
+    const std::vector<benchmark_result_t> &BenchmarkSuite::results() const
+    {
+        return m_results;
+    }
+
+    benchmark_result_t BenchmarkSuite::run(
+        const std::string &name,
+        const std::function<void()> &function,
+        size_t iterations,
+        size_t batch,
+        const std::function<void()> &setup)
+    {
+        iterations = std::max<size_t>(iterations, 1);
+
+        batch = std::max<size_t>(batch, 1);
+
+        m_random.seed(m_seed);
+
+        // warm up the caches (and the branch predictor) before we start measuring
+        if (setup)
+        {
+            setup();
+        }
+
+        function();
+
+        std::vector<double> samples;
+
+        samples.reserve(iterations);
+
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            if (setup)
+            {
+                setup();
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+
+            for (size_t j = 0; j < batch; ++j)
+            {
+                function();
+            }
+
+            const auto elapsed =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            samples.push_back(static_cast<double>(elapsed.count()) / batch);
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        benchmark_result_t result;
+
+        result.name = name;
+
+        result.iterations = iterations;
+
+        result.batch = batch;
+
+        double total = 0;
+
+        for (const auto &sample : samples)
+        {
+            total += sample;
+        }
+
+        result.mean = total / samples.size();
+
+        result.minimum = samples.front();
+
+        result.maximum = samples.back();
+
+        result.p50 = percentile(samples, 0.50);
+
+        result.p99 = percentile(samples, 0.99);
+
+        std::cout << std::setw(BENCHMARK_NAME_WIDTH) << std::left << name << std::setw(BENCHMARK_COLUMN_WIDTH)
+                  << std::right << iterations * batch << std::fixed << std::setprecision(0)
+                  << std::setw(BENCHMARK_COLUMN_WIDTH) << result.mean << std::setw(BENCHMARK_COLUMN_WIDTH)
+                  << result.p50 << std::setw(BENCHMARK_COLUMN_WIDTH) << result.p99 << std::endl;
+
+        m_results.push_back(result);
+
+        return result;
+    }
+
+    bool BenchmarkSuite::save_json(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+        if (!file)
+        {
+            return false;
+        }
+
+        file << to_json() << std::endl;
+
+        return file.good();
+    }
+
+    uint64_t BenchmarkSuite::seed() const
+    {
+        return m_seed;
+    }
+
+    std::string BenchmarkSuite::to_json() const
+    {
+        JSON_INIT_BUFFER(buffer, writer);
+
+        writer.StartObject();
+        {
+            writer.Key("name");
+            writer.String(m_name);
+
+            writer.Key("context");
+            writer.StartObject();
+            {
+                for (const auto &[key, value] : m_context)
+                {
+                    writer.Key(key);
+                    writer.String(value);
+                }
+            }
+            writer.EndObject();
+
+            writer.Key("benchmarks");
+            writer.StartArray();
+            {
+                for (const auto &result : m_results)
+                {
+                    writer.StartObject();
+                    {
+                        writer.Key("name");
+                        writer.String(result.name);
+
+                        writer.Key("iterations");
+                        writer.Uint64(result.iterations);
+
+                        writer.Key("batch");
+                        writer.Uint64(result.batch);
+
+                        writer.Key("time_unit");
+                        writer.String("ns");
+
+                        writer.Key("mean");
+                        writer.Double(result.mean);
+
+                        writer.Key("min");
+                        writer.Double(result.minimum);
+
+                        writer.Key("max");
+                        writer.Double(result.maximum);
+
+                        writer.Key("p50");
+                        writer.Double(result.p50);
+
+                        writer.Key("p99");
+                        writer.Double(result.p99);
+                    }
+                    writer.EndObject();
+                }
+            }
+            writer.EndArray();
+        }
+        writer.EndObject();
+
+        JSON_DUMP_BUFFER(buffer, result);
+
+        return result;
+    }
+} // namespace Utilities
@@ -0,0 +1,141 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef TURTLECOIN_UTILITIES_BENCHMARK_SUITE_H
+#define TURTLECOIN_UTILITIES_BENCHMARK_SUITE_H
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Utilities
+{
+    /**
+     * The timing results of a single benchmark, all times are expressed in nanoseconds per operation
+     */
+    struct benchmark_result_t
+    {
+        std::string name;
+
+        size_t iterations = 0;
+
+        // the number of operations performed per timed iteration
+        size_t batch = 1;
+
+        double mean = 0, minimum = 0, maximum = 0, p50 = 0, p99 = 0;
+    };
+
+    /**
+     * A collection of micro-benchmarks that share a fixed random seed and report their
+     * results to the console as they complete and, optionally, as a JSON document so that
+     * the numbers from different releases may be compared
+     *
+     * Each benchmark runs the supplied function for the specified number of iterations
+     * after a short warm up and records the duration of every iteration individually so
+     * that the percentiles may be reported. Functions that complete in less than a
+     * microsecond should be run in batches so that the clock overhead does not dominate.
+     *
+     * The random number generator is reseeded with the suite seed before each benchmark
+     * so that the inputs of a benchmark do not depend on the benchmarks that ran before it.
+     */
+    class BenchmarkSuite
+    {
+      public:
+        /**
+         * Constructs a new benchmark suite
+         *
+         * @param name
+         * @param seed
+         */
+        BenchmarkSuite(std::string name, uint64_t seed = DEFAULT_SEED);
+
+        /**
+         * Records the key/value pair in the context section of the JSON output
+         *
+         * @param key
+         * @param value
+         */
+        void add_context(const std::string &key, const std::string &value);
+
+        /**
+         * Prints a section header followed by the column headers to the console
+         *
+         * @param section
+         */
+        void print_header(const std::string &section) const;
+
+        /**
+         * Returns the random number generator of the suite
+         *
+         * @return
+         */
+        std::mt19937_64 &random();
+
+        /**
+         * Returns the results of the benchmarks that have been run in the order that they ran
+         *
+         * @return
+         */
+        [[nodiscard]] const std::vector<benchmark_result_t> &results() const;
+
+        /**
+         * Runs the benchmark and prints the result to the console
+         *
+         * The setup function, if supplied, runs before every iteration and is not timed
+         *
+         * @param name
+         * @param function
+         * @param iterations
+         * @param batch the number of times the function is called per timed iteration
+         * @param setup
+         * @return
+         */
+        benchmark_result_t run(
+            const std::string &name,
+            const std::function<void()> &function,
+            size_t iterations,
+            size_t batch = 1,
+            const std::function<void()> &setup = nullptr);
+
+        /**
+         * Writes the results to the specified file as a JSON document
+         *
+         * @param path
+         * @return whether the file was written
+         */
+        bool save_json(const std::string &path) const;
+
+        /**
+         * Returns the seed used by the suite
+         *
+         * @return
+         */
+        [[nodiscard]] uint64_t seed() const;
+
+        /**
+         * Returns the results as a JSON document
+         *
+         * @return
+         */
+        [[nodiscard]] std::string to_json() const;
+
+        static const uint64_t DEFAULT_SEED = 0x7475727463646e;
+
+      private:
+        std::string m_name;
+
+        uint64_t m_seed;
+
+        std::mt19937_64 m_random;
+
+        std::vector<std::tuple<std::string, std::string>> m_context;
+
+        std::vector<benchmark_result_t> m_results;
+    };
+} // namespace Utilities
+
+#endif
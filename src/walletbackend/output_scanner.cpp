@@ -0,0 +1,229 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#include "output_scanner.h"
+
+#include <atomic>
+#include <crypto.h>
+
+namespace WalletBackend
+{
+    OutputScanner::OutputScanner(size_t threads): m_threads(std::max<size_t>(threads, 1)) {}
+
+    void OutputScanner::add_wallet(
+        const crypto_secret_key_t &private_view,
+        const std::vector<crypto_public_key_t> &public_spends)
+    {
+        const auto public_view = Crypto::secret_key_to_public_key(private_view);
+
+        std::scoped_lock lock(m_mutex);
+
+        auto &wallet = m_wallets[public_view];
+
+        wallet.private_view = private_view;
+
+        wallet.public_spends.insert(public_spends.begin(), public_spends.end());
+    }
+
+    void OutputScanner::collect(
+        uint64_t block_index,
+        const transaction_t &transaction,
+        std::vector<scan_transaction_t> &work)
+    {
+        std::visit(
+            [&](auto &&arg)
+            {
+                USEVARIANT(T, arg);
+
+                // staker outputs are paid to staker IDs and are not one-time outputs
+                if constexpr (!std::is_same_v<T, staker_transaction_t>)
+                {
+                    if (arg.outputs.empty())
+                    {
+                        return;
+                    }
+
+                    scan_transaction_t entry;
+
+                    entry.block_index = block_index;
+
+                    entry.txn_hash = arg.hash();
+
+                    entry.public_key = arg.public_key;
+
+                    entry.outputs = arg.outputs;
+
+                    work.push_back(entry);
+                }
+            },
+            transaction);
+    }
+
+    void OutputScanner::del_wallet(const crypto_public_key_t &public_view)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        m_wallets.erase(public_view);
+    }
+
+    std::vector<scanned_output_t> OutputScanner::scan(const std::vector<scan_transaction_t> &work) const
+    {
+        std::vector<std::tuple<crypto_public_key_t, wallet_t>> wallets;
+
+        {
+            std::scoped_lock lock(m_mutex);
+
+            for (const auto &[public_view, wallet] : m_wallets)
+            {
+                wallets.emplace_back(public_view, wallet);
+            }
+        }
+
+        const auto total = work.size() * wallets.size();
+
+        if (total == 0)
+        {
+            return {};
+        }
+
+        // each work item is a (transaction, wallet) pair and requires exactly one key derivation
+        std::atomic<size_t> next_item = 0;
+
+        const auto thread_count = std::min(m_threads, total);
+
+        std::vector<std::vector<std::tuple<size_t, scanned_output_t>>> found(thread_count);
+
+        const auto worker = [&](size_t thread_id)
+        {
+            for (auto item = next_item++; item < total; item = next_item++)
+            {
+                const auto &transaction = work[item / wallets.size()];
+
+                const auto &[public_view, wallet] = wallets[item % wallets.size()];
+
+                const auto derivation = Crypto::generate_key_derivation(transaction.public_key, wallet.private_view);
+
+                for (size_t i = 0; i < transaction.outputs.size(); ++i)
+                {
+                    const auto &output = transaction.outputs[i];
+
+                    const auto derivation_scalar = Crypto::derivation_to_scalar(derivation, i);
+
+                    const auto public_spend = Crypto::underive_public_key(derivation_scalar, output.public_ephemeral);
+
+                    if (wallet.public_spends.find(public_spend) == wallet.public_spends.end())
+                    {
+                        continue;
+                    }
+
+                    scanned_output_t result;
+
+                    result.block_index = transaction.block_index;
+
+                    result.txn_hash = transaction.txn_hash;
+
+                    result.output_index = i;
+
+                    result.output = output;
+
+                    result.public_view = public_view;
+
+                    result.public_spend = public_spend;
+
+                    result.derivation_scalar = derivation_scalar;
+
+                    found[thread_id].emplace_back(item, result);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (size_t i = 1; i < thread_count; ++i)
+        {
+            threads.emplace_back(worker, i);
+        }
+
+        worker(0);
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        // restore the work order so that the results do not depend on thread scheduling
+        std::vector<std::tuple<size_t, scanned_output_t>> merged;
+
+        for (auto &results : found)
+        {
+            merged.insert(merged.end(), results.begin(), results.end());
+        }
+
+        std::stable_sort(
+            merged.begin(),
+            merged.end(),
+            [](const auto &left, const auto &right) { return std::get<0>(left) < std::get<0>(right); });
+
+        std::vector<scanned_output_t> results;
+
+        results.reserve(merged.size());
+
+        for (const auto &[item, result] : merged)
+        {
+            results.push_back(result);
+        }
+
+        return results;
+    }
+
+    std::vector<scanned_output_t>
+        OutputScanner::scan(const block_t &block, const std::vector<transaction_t> &transactions) const
+    {
+        std::vector<scan_transaction_t> work;
+
+        std::visit([&](auto &&arg) { collect(block.block_index, arg, work); }, block.reward_tx);
+
+        for (const auto &transaction : transactions)
+        {
+            collect(block.block_index, transaction, work);
+        }
+
+        return scan(work);
+    }
+
+    std::tuple<Error, std::vector<scanned_output_t>> OutputScanner::scan(
+        const std::shared_ptr<Core::BlockchainStorage> &blockchain_storage,
+        uint64_t start_index,
+        uint64_t end_index) const
+    {
+        std::vector<scan_transaction_t> work;
+
+        // gather the whole range first so that the work is spread over all threads at once
+        for (auto block_index = start_index; block_index < end_index; ++block_index)
+        {
+            const auto [error, block, transactions] = blockchain_storage->get_block(block_index);
+
+            if (error)
+            {
+                return {error, {}};
+            }
+
+            std::visit([&](auto &&arg) { collect(block_index, arg, work); }, block.reward_tx);
+
+            for (const auto &transaction : transactions)
+            {
+                collect(block_index, transaction, work);
+            }
+        }
+
+        return {MAKE_ERROR(SUCCESS), scan(work)};
+    }
+
+    size_t OutputScanner::wallet_count() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        return m_wallets.size();
+    }
+} // namespace WalletBackend
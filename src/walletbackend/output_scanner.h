@@ -0,0 +1,163 @@
+// Copyright (c) 2021, The TurtleCoin Developers
+//
+// Please see the included LICENSE file for more information.
+
+#ifndef WALLETBACKEND_OUTPUT_SCANNER_H
+#define WALLETBACKEND_OUTPUT_SCANNER_H
+
+#include <blockchain_storage.h>
+#include <errors.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <types.h>
+
+using namespace Types::Blockchain;
+
+namespace WalletBackend
+{
+    /**
+     * An output found while scanning that belongs to one of the registered wallets
+     */
+    struct scanned_output_t
+    {
+        uint64_t block_index = 0;
+
+        crypto_hash_t txn_hash;
+
+        // the index of the output within the transaction
+        size_t output_index = 0;
+
+        transaction_output_t output;
+
+        // identifies the wallet that owns the output
+        crypto_public_key_t public_view;
+
+        // identifies the subwallet that owns the output
+        crypto_public_key_t public_spend;
+
+        /**
+         * Used with the private spend key of the subwallet to derive the secret ephemeral
+         * (and thus the key image) and with the amount mask to unmask the amount
+         */
+        crypto_scalar_t derivation_scalar;
+    };
+
+    /**
+     * Scans transaction outputs for those that belong to one or more wallets using the
+     * private view key of each wallet and the public spend keys of its subwallets
+     *
+     * The key derivation of each (transaction, wallet) pair is computed once and then
+     * reused for every output of the transaction; the owning subwallet is found by
+     * underiving the public spend key from the output public ephemeral and looking it
+     * up in the set of subwallet public spend keys. The (transaction, wallet) pairs of
+     * the blocks being scanned are spread across the worker threads.
+     */
+    class OutputScanner
+    {
+      public:
+        /**
+         * Constructs a new instance of the output scanner
+         *
+         * @param threads the number of threads used for scanning
+         */
+        OutputScanner(size_t threads = std::thread::hardware_concurrency());
+
+        /**
+         * Adds (or extends) a wallet with the specified subwallet public spend keys
+         *
+         * @param private_view
+         * @param public_spends
+         */
+        void add_wallet(const crypto_secret_key_t &private_view, const std::vector<crypto_public_key_t> &public_spends);
+
+        /**
+         * Removes the wallet with the specified public view key
+         *
+         * @param public_view
+         */
+        void del_wallet(const crypto_public_key_t &public_view);
+
+        /**
+         * Scans the block and its transactions for outputs belonging to the registered wallets
+         *
+         * @param block
+         * @param transactions
+         * @return
+         */
+        [[nodiscard]] std::vector<scanned_output_t>
+            scan(const block_t &block, const std::vector<transaction_t> &transactions) const;
+
+        /**
+         * Scans the range of blocks [start_index, end_index) from the blockchain storage for
+         * outputs belonging to the registered wallets
+         *
+         * The results are ordered by block, then by the order of the transactions in the block
+         * (reward transaction first), then by output index
+         *
+         * @param blockchain_storage
+         * @param start_index
+         * @param end_index
+         * @return [error, outputs]
+         */
+        [[nodiscard]] std::tuple<Error, std::vector<scanned_output_t>> scan(
+            const std::shared_ptr<Core::BlockchainStorage> &blockchain_storage,
+            uint64_t start_index,
+            uint64_t end_index) const;
+
+        /**
+         * Returns the number of registered wallets
+         *
+         * @return
+         */
+        [[nodiscard]] size_t wallet_count() const;
+
+      private:
+        struct wallet_t
+        {
+            crypto_secret_key_t private_view;
+
+            std::set<crypto_public_key_t> public_spends;
+        };
+
+        struct scan_transaction_t
+        {
+            uint64_t block_index = 0;
+
+            crypto_hash_t txn_hash;
+
+            crypto_public_key_t public_key;
+
+            std::vector<transaction_output_t> outputs;
+        };
+
+        /**
+         * Adds the transaction to the work list if it carries outputs that may be scanned
+         *
+         * @param block_index
+         * @param transaction
+         * @param work
+         */
+        static void collect(
+            uint64_t block_index,
+            const transaction_t &transaction,
+            std::vector<scan_transaction_t> &work);
+
+        /**
+         * Scans the transactions against all of the wallets using the worker threads
+         *
+         * @param work
+         * @return
+         */
+        [[nodiscard]] std::vector<scanned_output_t> scan(const std::vector<scan_transaction_t> &work) const;
+
+        size_t m_threads;
+
+        std::map<crypto_public_key_t, wallet_t> m_wallets;
+
+        mutable std::mutex m_mutex;
+    };
+} // namespace WalletBackend
+
+#endif // WALLETBACKEND_OUTPUT_SCANNER_H